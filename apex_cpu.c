@@ -6,35 +6,37 @@
  * Copyright (c) 2020, Gaurav Kothari (gkothar1@binghamton.edu)
  * State University of New York at Binghamton
  */
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "apex_cpu.h"
 #include "apex_macros.h"
+#include "memory_image.h"
 
 /*
 This method is used to print the contents of the godzilla stage - the IQ, ROB and LSQ
 */
 void print_godzilla (APEX_CPU *cpu) {
-    printf("\nContents of godzilla are:\npd: %d, ps1: %d, ps2: %d, imm: %d, rd: %d, opcode: %d\n\n", cpu->godzilla.pd, cpu->godzilla.ps1, cpu->godzilla.ps2, cpu->godzilla.imm, cpu->godzilla.rd, cpu->godzilla.opcode);
+    printf("\nContents of godzilla are:\npd: %d, ps1: %d, ps2: %d, imm: %d, rd: %d, opcode: %d\n\n", cpu->thread->godzilla.pd, cpu->thread->godzilla.ps1, cpu->thread->godzilla.ps2, cpu->thread->godzilla.imm, cpu->thread->godzilla.rd, cpu->thread->godzilla.opcode);
 
     printf("\nPrinting the IQ:\n");
     printf("\nisValid  |  FU       |  literal  |  ps1-valid|  ps1-tag  |  ps2-valid|  ps2-tag  |  dest-type|  dest     |\n");
     for (int i = 0; i < IQ_SIZE; i++) {
-        printf("%-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|\n", cpu->cpu_iq[i].isValid, cpu->cpu_iq[i].FU, cpu->cpu_iq[i].literal, cpu->cpu_iq[i].ps1_valid, cpu->cpu_iq[i].ps1_tag, cpu->cpu_iq[i].ps2_valid, cpu->cpu_iq[i].ps2_tag, cpu->cpu_iq[i].dest_type, cpu->cpu_iq[i].dest);
+        printf("%-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|\n", bitset_test(cpu->iq_sched.valid, i), cpu->cpu_iq[i].FU, cpu->cpu_iq[i].literal, bitset_test(cpu->iq_sched.ps1_ready, i), cpu->iq_sched.ps1_tag[i], bitset_test(cpu->iq_sched.ps2_ready, i), cpu->iq_sched.ps2_tag[i], cpu->cpu_iq[i].dest_type, cpu->cpu_iq[i].dest);
     }
 
     printf("\nPrinting the ROB:\n");
     printf("\n    |  isValid  |  insn_type|  pc       |  pd       |  ovwrtn_pd|  rd       |  lsq_index |\n");
     for (int i = 0; i < ROB_SIZE; i++) {
-        printf("%-4c|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|\n", i == cpu->rob_head ? '--' : ' ', cpu->cpu_rob[i].isValid, cpu->cpu_rob[i].insn_type, cpu->cpu_rob[i].pc, cpu->cpu_rob[i].pd, cpu->cpu_rob[i].overwritten_pd, cpu->cpu_rob[i].rd, cpu->cpu_rob[i].lsq_index);
+        printf("%-4c|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|\n", i == cpu->thread->rob_head ? '--' : ' ', cpu->thread->cpu_rob[i].isValid, cpu->thread->cpu_rob[i].insn_type, cpu->thread->cpu_rob[i].pc, cpu->thread->cpu_rob[i].pd, cpu->thread->cpu_rob[i].overwritten_pd, cpu->thread->cpu_rob[i].rd, cpu->thread->cpu_rob[i].lsq_index);
     }
 
     printf("\nPrinting the LSQ:\n");
     printf("\nisValid  |  ld/store |  mem_valid|  memory   |  dest     |  ps1_valid|  ps1_tag  |  pd       |\n");
     for (int i = 0; i < LSQ_SIZE; i++) {
-        printf("%-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|\n", cpu->cpu_lsq[i].isValid, cpu->cpu_lsq[i].lORs, cpu->cpu_lsq[i].mem_valid, cpu->cpu_lsq[i].memory, cpu->cpu_lsq[i].dest, cpu->cpu_lsq[i].ps1_valid, cpu->cpu_lsq[i].ps1_tag, cpu->cpu_lsq[i].pd);
+        printf("%-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|  %-9d|\n", cpu->thread->cpu_lsq[i].isValid, cpu->thread->cpu_lsq[i].lORs, cpu->thread->cpu_lsq[i].mem_valid, cpu->thread->cpu_lsq[i].memory, cpu->thread->cpu_lsq[i].dest, cpu->thread->cpu_lsq[i].ps1_valid, cpu->thread->cpu_lsq[i].ps1_tag, cpu->thread->cpu_lsq[i].pd);
     }
 }
 
@@ -50,6 +52,9 @@ void print_execute (APEX_CPU *cpu) {
 
     printf("\nPrinting the contents of MULFU\n");
     printf("\nhas_insn = %d, pd = %d, ps1 = %d, ps2 = %d\n", cpu->execute.intFU.has_insn, cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
+
+    printf("\nPrinting the contents of DIVFU\n");
+    printf("\nhas_insn = %d, pd = %d, ps1 = %d, ps2 = %d\n", cpu->execute.divFU.has_insn, cpu->execute.divFU.pd, cpu->execute.divFU.ps1, cpu->execute.divFU.ps2);
 }
 
 /*
@@ -58,7 +63,7 @@ This method is used to print the PRF
 void print_prf (APEX_CPU *cpu) {
     printf("\nPrinting the PRF\n");
     printf("\nReg      |  isValid  |  Value    \n");
-    for (int i = 0; i < PRF_SIZE; i++) {
+    for (int i = 0; i < cpu->prf_size; i++) {
         printf("%-9d|  %-9d|  %-9d|\n", i, cpu->cpu_prf[i].isValid, cpu->cpu_prf[i].value);
     }
     printf("\n\n");
@@ -82,6 +87,7 @@ print_instruction(const CPU_Stage *stage)
         case OPCODE_ADD:
         case OPCODE_SUB:
         case OPCODE_MUL:
+        case OPCODE_DIV:
         case OPCODE_AND:
         case OPCODE_OR:
         case OPCODE_XOR:
@@ -173,21 +179,21 @@ void print_phy_reg_file (APEX_CPU *cpu) {
 
     printf("----------\n%s\n----------\n", "Registers:");
 
-    for (int i = 0; i < PRF_SIZE / 2; ++i)
+    for (int i = 0; i < cpu->prf_size / 2; ++i)
     {
         printf("R%-3d[%-3d] ", i, cpu->cpu_prf[i].value);
     }
 
     printf("\n");
 
-    for (i = (PRF_SIZE / 2); i < PRF_SIZE; ++i)
+    for (i = (cpu->prf_size / 2); i < cpu->prf_size; ++i)
     {
         printf("R%-3d[%-3d] ", i, cpu->cpu_prf[i].value);
     }
 
     printf("\n");
 
-    // printf("Z: %-3d P: %-3d N: %-3d ", cpu->zero_flag, cpu->positive_flag, cpu->negative_flag);
+    // printf("Z: %-3d P: %-3d N: %-3d ", cpu->thread->zero_flag, cpu->thread->positive_flag, cpu->thread->negative_flag);
 
     printf("\n\n");
 }
@@ -205,27 +211,37 @@ print_reg_file(const APEX_CPU *cpu)
 
     for (int i = 0; i < REG_FILE_SIZE / 2; ++i)
     {
-        printf("R%-3d[%-3d] ", i, cpu->regs[i]);
+        printf("R%-3d[%-3d] ", i, cpu->thread->regs[i]);
     }
 
     printf("\n");
 
     for (i = (REG_FILE_SIZE / 2); i < REG_FILE_SIZE; ++i)
     {
-        printf("R%-3d[%-3d] ", i, cpu->regs[i]);
+        printf("R%-3d[%-3d] ", i, cpu->thread->regs[i]);
     }
 
     printf("\n");
 
-    printf("Z: %-3d P: %-3d N: %-3d ", cpu->zero_flag, cpu->positive_flag, cpu->negative_flag);
+    printf("Z: %-3d P: %-3d N: %-3d ", cpu->thread->zero_flag, cpu->thread->positive_flag, cpu->thread->negative_flag);
 
     printf("\n\n");
 
-    for(i = 0; i < DATA_MEMORY_SIZE; i++)
+    for(i = 0; i < DATA_MEMORY_PAGES; i++)
     {
-        if(cpu->data_memory[i] != 0)
+        const int *page = cpu->data_memory.page_table[i];
+
+        if(page == NULL)
+        {
+            continue;
+        }
+
+        for(int j = 0; j < DATA_MEMORY_PAGE_SIZE; j++)
         {
-            printf("MEM[%-3d]: %-3d", i, cpu->data_memory[i]);
+            if(page[j] != 0)
+            {
+                printf("MEM[%-3d]: %-3d", (i << DATA_MEMORY_PAGE_BITS) + j, page[j]);
+            }
         }
     }
 
@@ -245,1675 +261,3726 @@ print_reg_file(const APEX_CPU *cpu)
 
 
 /*
-Akash, edit this function according to your requirement
+This method returns TRUE for the instructions that set the condition flags from their result
 */
-static void
-APEX_fetch(APEX_CPU *cpu)
-{
-    APEX_Instruction *current_ins;
+static int insn_sets_flags (int opcode) {
+    switch (opcode) {
+        case OPCODE_ADD:
+        case OPCODE_ADDL:
+        case OPCODE_SUB:
+        case OPCODE_SUBL:
+        case OPCODE_MUL:
+        case OPCODE_DIV:
+        case OPCODE_CMP:
+        case OPCODE_CML:
+            return TRUE;
+    }
 
-    if (cpu->fetch.has_insn)
-    {
-        if(cpu->decode_from_next_cycle == TRUE)
-        {
-            cpu->fetch_from_next_cycle = TRUE;
+    return FALSE;
+}
+
+/*
+This method returns the FLAG_* bits a flag-producing instruction sets for its result
+*/
+static int result_flags (int result) {
+    return (result == 0 ? FLAG_ZERO : 0) | (result > 0 ? FLAG_POSITIVE : 0) | (result < 0 ? FLAG_NEGATIVE : 0);
+}
+
+/*
+This method returns TRUE for the branches taken or not depending on the condition flags
+*/
+static int is_conditional_branch (int opcode) {
+    switch (opcode) {
+        case OPCODE_BZ:
+        case OPCODE_BNZ:
+        case OPCODE_BP:
+        case OPCODE_BNP:
+        case OPCODE_BN:
+        case OPCODE_BNN:
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+/*
+This method returns TRUE for the register-indirect control transfers
+*/
+static int is_indirect_jump (int opcode) {
+    return opcode == OPCODE_JUMP || opcode == OPCODE_JALR;
+}
+
+/*
+This method returns TRUE for the instructions fetch predicts past, which take a rename checkpoint
+*/
+static int is_branch (int opcode) {
+    return is_conditional_branch(opcode) || is_indirect_jump(opcode);
+}
+
+/*
+This method records in the pipeline trace, if one is being written, that an instruction reached a stage
+in the current cycle
+*/
+static void trace_stage (APEX_CPU *cpu, int seq, int stage) {
+    if (cpu->pipeview) {
+        pipeview_stamp(cpu->pipeview, seq, stage, cpu->clock + 1);
+    }
+}
+
+#if LOOP_BUFFER
+/*
+This method follows the instruction just fetched into the loop buffer. A conditional branch predicted taken
+backwards over a body that fits starts a capture: the fetch latches of the body are recorded as fetch goes
+through it, on any path, and the buffer replays once every one of them is in. Leaving the body, or a
+JUMP/JALR whose target is not static, drops the capture.
+*/
+static void loop_buffer_capture (APEX_CPU *cpu) {
+    Loop_Buffer *lb = &cpu->thread->loop_buffer;
+    const CPU_Stage *insn = &cpu->thread->fetch;
+    int size;
+
+    if (lb->state == LOOP_BUFFER_CAPTURE) {
+        if (insn->pc < lb->start_pc || insn->pc > lb->end_pc || is_indirect_jump(insn->opcode)) {
+            lb->state = LOOP_BUFFER_IDLE;
         }
-        /* This fetches new branch target instruction from next cycle */
-        if (cpu->fetch_from_next_cycle == TRUE)
-        {
-            cpu->fetch_from_next_cycle = FALSE;
-            if (ENABLE_DEBUG_MESSAGES)
-            {
-                // print_stage_content("Fetch", &cpu->fetch);
+        else {
+            lb->entries[(insn->pc - lb->start_pc) / 4] = *insn;
+            lb->captured |= 1ull << ((insn->pc - lb->start_pc) / 4);
+            if (lb->captured == lb->complete) {
+                lb->state = LOOP_BUFFER_REPLAY;
             }
-            /* Skip this cycle*/
             return;
         }
+    }
+
+    size = -insn->imm / 4 + 1;
+    if (lb->state == LOOP_BUFFER_IDLE && is_conditional_branch(insn->opcode) && insn->imm < 0 &&
+        insn->imm % 4 == 0 && size <= LOOP_BUFFER_SIZE) {
+        lb->start_pc = insn->pc + insn->imm;
+        lb->end_pc = insn->pc;
+        lb->entries[size - 1] = *insn;
+        lb->captured = 1ull << (size - 1);
+        lb->complete = size == 64 ? ~0ull : (1ull << size) - 1;
+        lb->state = LOOP_BUFFER_CAPTURE;
+    }
+}
 
-        /* Store current PC in fetch latch */
-        cpu->fetch.pc = cpu->pc;
+/*
+This method fetches the instruction at the PC from the loop buffer, decoded and predicted as it was when
+captured; only the pipeline trace still reads code memory. Fetch calls it twice per cycle, so that replay
+delivers two instructions where code memory delivers one. Returns FALSE, leaving replay, once the PC is
+outside the loop body.
+*/
+static int loop_buffer_replay (APEX_CPU *cpu) {
+    Loop_Buffer *lb = &cpu->thread->loop_buffer;
+
+    if (cpu->thread->pc < lb->start_pc || cpu->thread->pc > lb->end_pc || (cpu->thread->pc - lb->start_pc) % 4 != 0) {
+        lb->state = LOOP_BUFFER_IDLE;
+        return FALSE;
+    }
+
+    cpu->thread->fetch = lb->entries[(cpu->thread->pc - lb->start_pc) / 4];
+    cpu->thread->fetch.seq = cpu->fetch_seq++;
+    cpu->thread->fetch.ras_state = target_predictor_ras_state(&cpu->thread->target_pred);
+    cpu->stats.loop_buffer_insns++;
+
+    if (cpu->pipeview) {
+        pipeview_fetch(cpu->pipeview, cpu->thread->fetch.seq, cpu->thread->fetch.pc,
+                       &cpu->thread->code_memory[get_code_memory_index_from_pc(cpu->thread->fetch.pc)], cpu->clock + 1);
+    }
+
+    cpu->thread->pc = cpu->thread->fetch.pred_target;
 
-        /* Index into code memory using this pc and copy all instruction fields
-         * into fetch latch  */
-        current_ins = &cpu->code_memory[get_code_memory_index_from_pc(cpu->pc)];
-        strcpy(cpu->fetch.opcode_str, current_ins->opcode_str);
-        cpu->fetch.opcode = current_ins->opcode;
-        cpu->fetch.rd = current_ins->rd;
-        cpu->fetch.rs1 = current_ins->rs1;
-        cpu->fetch.rs2 = current_ins->rs2;
-        cpu->fetch.imm = current_ins->imm;
+    return TRUE;
+}
+#endif
+
+/*
+This method fetches the instruction at the PC into the fetch latch, predicts the PC of the one after it
+and moves the PC there. Returns FALSE, fetching nothing, if the PC is outside the code.
+*/
+static int fetch_instruction (APEX_CPU *cpu) {
+    APEX_Instruction *current_ins;
+    int code_index;
+    int next_pc;
+
+#if LOOP_BUFFER
+    if (cpu->thread->loop_buffer.state == LOOP_BUFFER_REPLAY && loop_buffer_replay(cpu))
+    {
+        return TRUE;
+    }
+#endif
 
-        /* Update PC for next instruction */
-        cpu->pc += 4;
+    /* A wrong path can run off the end of the code, fetch waits there for the flush */
+    code_index = get_code_memory_index_from_pc(cpu->thread->pc);
+    if (code_index < 0 || code_index >= cpu->thread->code_memory_size || cpu->thread->pc % 4 != 0)
+    {
+        return FALSE;
+    }
 
-        if(cpu->decode_rename.has_insn == FALSE)
+    /* Store current PC in fetch latch */
+    cpu->thread->fetch.pc = cpu->thread->pc;
+
+    /* Index into code memory using this pc and copy all instruction fields
+     * into fetch latch  */
+    current_ins = &cpu->thread->code_memory[code_index];
+    strcpy(cpu->thread->fetch.opcode_str, current_ins->opcode_str);
+    cpu->thread->fetch.opcode = current_ins->opcode;
+    cpu->thread->fetch.rd = current_ins->rd;
+    cpu->thread->fetch.rs1 = current_ins->rs1;
+    cpu->thread->fetch.rs2 = current_ins->rs2;
+    cpu->thread->fetch.imm = current_ins->imm;
+    cpu->thread->fetch.seq = cpu->fetch_seq++;
+    cpu->thread->fetch.pred_source = TARGET_PRED_NONE;
+    cpu->thread->fetch.fused_opcode = -1;
+    cpu->thread->fetch.fused_rd = -1;
+    next_pc = cpu->thread->pc + 4;
+
+    /* Conditional branches are predicted taken backwards and not taken forwards, JUMP/JALR follow the
+       target predictor and wait in fetch when it has no target */
+    if (is_conditional_branch(cpu->thread->fetch.opcode))
+    {
+        if (cpu->thread->fetch.imm < 0)
         {
-            /* Copy data from fetch latch to decode latch*/
-            cpu->decode_rename = cpu->fetch;
+            next_pc = cpu->thread->pc + cpu->thread->fetch.imm;
         }
-        else
+    }
+    else if (is_indirect_jump(cpu->thread->fetch.opcode))
+    {
+        cpu->thread->fetch.pred_source = target_predictor_predict(&cpu->thread->target_pred, cpu->thread->fetch.opcode, cpu->thread->fetch.pc,
+                                                          cpu->thread->fetch.rs1, cpu->thread->fetch.rd, &cpu->thread->fetch.pred_target);
+        if (cpu->thread->fetch.pred_source != TARGET_PRED_NONE)
         {
-            cpu->fetch_from_next_cycle = TRUE;            
+            next_pc = cpu->thread->fetch.pred_target;
         }
-
-        if (ENABLE_DEBUG_MESSAGES)
+        else
         {
-            print_stage_content("Fetch", &cpu->fetch);
+            cpu->thread->branch_in_flight = TRUE;
         }
+    }
 
-        /* Stop fetching new instructions if HALT is fetched */
-        if (cpu->fetch.opcode == OPCODE_HALT)
-        {
-            cpu->fetch.has_insn = FALSE;
-        }
+    cpu->thread->fetch.pred_target = next_pc;
+    cpu->thread->fetch.ras_state = target_predictor_ras_state(&cpu->thread->target_pred);
+
+    if (cpu->pipeview) {
+        pipeview_fetch(cpu->pipeview, cpu->thread->fetch.seq, cpu->thread->fetch.pc, current_ins, cpu->clock + 1);
     }
+
+    /* Update PC for next instruction */
+    cpu->thread->pc = next_pc;
+
+#if LOOP_BUFFER
+    loop_buffer_capture(cpu);
+#endif
+
+    return TRUE;
 }
 
+/*
+Akash, edit this function according to your requirement
+*/
 static void
-APEX_Decode(APEX_CPU *cpu)
+APEX_fetch(APEX_CPU *cpu)
 {
-    if(cpu->decode_rename.has_insn)
+    if (cpu->thread->fetch.has_insn)
     {
-        if(cpu->dispatch_from_next_cycle == TRUE)
+        /* Hold the PC while decode and the fetch buffer both hold an instruction, or while the JUMP/JALR
+           fetched last has no predicted target */
+        if ((cpu->thread->decode_rename.has_insn && cpu->thread->fetch_buffer.has_insn) || cpu->thread->branch_in_flight)
         {
-            cpu->decode_from_next_cycle = TRUE;
+            return;
         }
-        if (cpu->decode_from_next_cycle == TRUE)
+
+        if (!fetch_instruction(cpu))
         {
-            cpu->decode_from_next_cycle = FALSE;
-            if (ENABLE_DEBUG_MESSAGES)
-            {
-                // print_stage_content("Fetch", &cpu->decode_rename);
-            }
-            /* Skip this cycle*/
             return;
         }
 
-        
-        // rs1 & rs2 renaming
-        switch (cpu->decode_rename.opcode)
+        /* Copy data from fetch latch to decode latch, or to the fetch buffer while decode is held */
+        if (cpu->thread->decode_rename.has_insn)
         {
-            case OPCODE_ADD:
-            case OPCODE_SUB:
-            case OPCODE_MUL:
-            case OPCODE_AND:
-            case OPCODE_OR:
-            case OPCODE_XOR:
-            case OPCODE_STORE:
-            case OPCODE_STOREP:
-            case OPCODE_CMP:
-            {
-                if(cpu->rename_table[cpu->decode_rename.rs1] == -1)
-                {
-                    cpu->decode_rename.ps1 = cpu->free_reg_list[cpu->free_reg_head];
-                    cpu->free_reg_head = (cpu->free_reg_head + 1) % PRF_SIZE;
-                    cpu->rename_table[cpu->decode_rename.rs1] = cpu->decode_rename.ps1;
-                }
-                else {
-                    cpu->decode_rename.ps1 = cpu->rename_table[cpu->decode_rename.rs1];
-                }
-                
-                if(cpu->rename_table[cpu->decode_rename.rs2] == -1)
-                {
-                    cpu->decode_rename.ps2 = cpu->free_reg_list[cpu->free_reg_head];
-                    cpu->free_reg_head = (cpu->free_reg_head + 1) % PRF_SIZE;
-                    cpu->rename_table[cpu->decode_rename.rs2] = cpu->decode_rename.ps2;
-                }
-                else {
-                    cpu->decode_rename.ps2 = cpu->rename_table[cpu->decode_rename.rs2];
-                }
+            cpu->thread->fetch_buffer = cpu->thread->fetch;
+        }
+        else
+        {
+            cpu->thread->decode_rename = cpu->thread->fetch;
+        }
 
-                cpu->cpu_prf[cpu->decode_rename.rs2].dependency_count += 1;
-                break;
-            }
+#if LOOP_BUFFER
+        /* Replay fills the fetch buffer too in the same cycle, decode then finds a pair to fuse */
+        if (cpu->thread->loop_buffer.state == LOOP_BUFFER_REPLAY && !cpu->thread->fetch_buffer.has_insn &&
+            cpu->thread->fetch.opcode != OPCODE_HALT && loop_buffer_replay(cpu))
+        {
+            cpu->thread->fetch_buffer = cpu->thread->fetch;
+        }
+#endif
 
-            case OPCODE_LOAD:
-            case OPCODE_LOADP:
-            case OPCODE_ADDL:
-            case OPCODE_SUBL:
-            case OPCODE_JALR:
-            case OPCODE_JUMP:
-            case OPCODE_CML:
-            {
-                if(cpu->rename_table[cpu->decode_rename.rs1] == -1)
-                {
-                    cpu->decode_rename.ps1 = cpu->free_reg_list[cpu->free_reg_head];
-                    cpu->free_reg_head = (cpu->free_reg_head + 1) % PRF_SIZE;
-                    cpu->rename_table[cpu->decode_rename.rs1] = cpu->decode_rename.ps1;
-                }
-                else {
-                    cpu->decode_rename.ps1 = cpu->rename_table[cpu->decode_rename.rs1];
-                }
-                break;
-            }
+        if (cpu->debug_messages)
+        {
+            print_stage_content("Fetch", &cpu->thread->fetch);
+        }
 
-            case OPCODE_MOVC:
-            case OPCODE_NOP:
-            {
-                cpu->decode_rename.ps1 = -2;
-                cpu->decode_rename.ps2 = -2;
-                break;
-            }
+        /* Stop fetching new instructions if HALT is fetched */
+        if (cpu->thread->fetch.opcode == OPCODE_HALT)
+        {
+            cpu->thread->fetch.has_insn = FALSE;
+        }
+    }
+}
 
-            case OPCODE_HALT:
-            {
-                cpu->decode_rename.ps1 = -2;
-                cpu->decode_rename.ps2 = -2;
-                cpu->fetch.has_insn = FALSE;
-                break;
-            }
+/*
+This method picks the thread that fetches in the current cycle among those whose fetch is not held, -1
+if there is none. SMT_FETCH_ROUND_ROBIN takes them in turns, SMT_FETCH_ICOUNT the one with the fewest
+instructions between decode and issue, so that a thread stalled in the back end does not fill the IQ.
+*/
+static int select_fetch_thread (const APEX_CPU *cpu) {
+    int icount[SMT_THREADS_MAX] = {0};
+    int best = -1;
 
-        
-            default:
-                break;
+    if (cpu->fetch_policy == SMT_FETCH_ICOUNT) {
+        for (int i = bitset_next(cpu->iq_sched.valid, IQ_WORDS, 0); i != -1; i = bitset_next(cpu->iq_sched.valid, IQ_WORDS, i + 1)) {
+            icount[cpu->cpu_iq[i].thread]++;
         }
-        
-        // rd renaming
+    }
 
-        switch (cpu->decode_rename.opcode)
-        {
-            case OPCODE_ADD:
-            case OPCODE_ADDL:
-            case OPCODE_SUB:
-            case OPCODE_SUBL:
-            case OPCODE_MUL:
-            case OPCODE_AND:
-            case OPCODE_OR:
-            case OPCODE_XOR:
-            case OPCODE_LOAD:
-            case OPCODE_MOVC:
-            case OPCODE_JALR:
-            {
-                cpu->overwritten_pd = cpu->rename_table[cpu->decode_rename.rd];
-                cpu->decode_rename.pd = cpu->free_reg_list[cpu->free_reg_head];
-                printf("\n%d is being overwritten to %d\n", cpu->rename_table[cpu->decode_rename.rd], cpu->decode_rename.pd);
-                cpu->rename_table[cpu->decode_rename.rd] = cpu->decode_rename.pd;
-                cpu->free_reg_head = (cpu->free_reg_head + 1) % PRF_SIZE;
-                cpu->cpu_prf[cpu->decode_rename.pd].isValid = FALSE;
-
-                printf("\nRename Table: \n");
-                for (int i = 0; i < REG_FILE_SIZE; i++) {
-                    printf("%d => %d\n", i, cpu->rename_table[i]);
-                }
-                printf("\n\n");
-                printf("\nFree list of registers: \n");
-                for (int i = cpu->free_reg_head + 1; i != cpu->free_reg_tail; i = (i + 1)%PRF_SIZE) {
-                    printf("%d\t", cpu->free_reg_list[i-1]);
-                }
-                printf("\n\n");
+    for (int n = 1; n <= cpu->thread_count; n++) {
+        int t = (cpu->fetch_thread + n) % cpu->thread_count;
+        const APEX_Thread *thread = &cpu->threads[t];
 
-                break;
-            }
+        if (!thread->fetch.has_insn || (thread->decode_rename.has_insn && thread->fetch_buffer.has_insn) ||
+            thread->branch_in_flight) {
+            continue;
+        }
 
-            case OPCODE_LOADP:
-            {
-                cpu->overwritten_pd = cpu->rename_table[cpu->decode_rename.rd];
-                cpu->decode_rename.pd = cpu->free_reg_list[cpu->free_reg_head];
-                cpu->rename_table[cpu->decode_rename.rd] = cpu->decode_rename.pd;
-                cpu->free_reg_head = (cpu->free_reg_head + 1) % PRF_SIZE;
-                cpu->cpu_prf[cpu->decode_rename.pd].isValid = FALSE;
-
-                cpu->decode_rename.lpsp_inc_dest = cpu->free_reg_list[cpu->free_reg_head];
-                cpu->rename_table[cpu->decode_rename.rs1] = cpu->decode_rename.lpsp_inc_dest;
-                cpu->free_reg_head = (cpu->free_reg_head + 1) % PRF_SIZE;
-                cpu->cpu_prf[cpu->decode_rename.lpsp_inc_dest].isValid = FALSE;
-
-                printf("\nRename Table: \n");
-                for (int i = 0; i < REG_FILE_SIZE; i++) {
-                    printf("%d => %d\n", i, cpu->rename_table[i]);
-                }
-                printf("\n\n");
-                printf("\nFree list of registers: \n");
-                for (int i = cpu->free_reg_head + 1; i != cpu->free_reg_tail; i = (i + 1)%PRF_SIZE) {
-                    printf("%d\t", cpu->free_reg_list[i-1]);
-                }
-                printf("\n\n");
+        if (cpu->fetch_policy == SMT_FETCH_ROUND_ROBIN) {
+            return t;
+        }
 
-                break;
-            }
+        icount[t] += thread->rename_dispatch.has_insn + thread->godzilla.insn_pending;
+        if (best == -1 || icount[t] < icount[best]) {
+            best = t;
+        }
+    }
 
-            case OPCODE_STOREP:
-            {
-                cpu->decode_rename.lpsp_inc_dest = cpu->free_reg_list[cpu->free_reg_head];
-                cpu->rename_table[cpu->decode_rename.rs2] = cpu->decode_rename.lpsp_inc_dest;
-                cpu->free_reg_head = (cpu->free_reg_head + 1) % PRF_SIZE;
-                cpu->cpu_prf[cpu->decode_rename.lpsp_inc_dest].isValid = FALSE;
+    return best;
+}
+
+/*
+This method is used to take the lowest free physical register. Every checkpoint in flight records it,
+so that a flush back to the checkpoint frees it again.
+*/
+static int allocate_phys_reg (APEX_CPU *cpu) {
+    int reg = bitset_next(cpu->free_regs, PRF_WORDS, 0);
 
-                printf("\nlpsp_inc_dest = %d, %d\n", cpu->decode_rename.lpsp_inc_dest);
+    bitset_clear(cpu->free_regs, reg);
+    cpu->free_reg_count--;
+    cpu->cpu_prf[reg].pending_retires = 1;
+    cpu->cpu_prf[reg].refs = 1;
 
-                break;
-            }
+    for (int i = 0; i < CHECKPOINT_COUNT; i++) {
+        if (cpu->thread->checkpoints[i].isValid) {
+            bitset_set(cpu->thread->checkpoints[i].allocated, reg);
         }
+    }
 
-        cpu->rename_dispatch = cpu->decode_rename;
-        cpu->rename_dispatch.has_insn = TRUE;
-        if (ENABLE_DEBUG_MESSAGES)
-        {
-            print_stage_content("Decode1", &cpu->decode_rename);
-        }        
-        cpu->decode_rename.has_insn = FALSE;
-        
+    return reg;
+}
+
+/*
+This method is used to drop a reference to a physical register, returning it to the free list with the last one
+*/
+static void release_phys_reg (APEX_CPU *cpu, int reg) {
+    if (--cpu->cpu_prf[reg].refs > 0) {
+        return;
     }
+
+    bitset_set(cpu->free_regs, reg);
+    cpu->free_reg_count++;
 }
 
-static int
-APEX_Dispatch(APEX_CPU *cpu)
-{
-    if(cpu->rename_dispatch.has_insn)
-    {
-        if(cpu->godzilla.enter_godzilla == FALSE)
-        {
-            cpu->dispatch_from_next_cycle = TRUE;
-        }
-        if(cpu->dispatch_from_next_cycle == TRUE)
-        {
-            cpu->dispatch_from_next_cycle = FALSE;
-            if (ENABLE_DEBUG_MESSAGES)
-            {
-                // print_stage_content("Fetch", &cpu->rename_dispatch);
-            }
-            /* Skip this cycle*/
-            return FALSE;
+#if RENAME_ELIMINATION
+/*
+This method is used to map one more register onto an allocated physical register
+*/
+static void share_phys_reg (APEX_CPU *cpu, int reg) {
+    cpu->cpu_prf[reg].refs++;
+    cpu->cpu_prf[reg].pending_retires++;
+
+    for (int i = 0; i < CHECKPOINT_COUNT; i++) {
+        if (cpu->thread->checkpoints[i].isValid) {
+            cpu->thread->checkpoints[i].shared[reg]++;
         }
+    }
+}
+#endif
 
-        cpu->godzilla.imm = cpu->rename_dispatch.imm;
-        cpu->godzilla.opcode = cpu->rename_dispatch.opcode;
-        strcpy(cpu->godzilla.opcode_str, cpu->rename_dispatch.opcode_str);
-        cpu->godzilla.overwritten_pd = cpu->overwritten_pd;
-        cpu->godzilla.pc = cpu->rename_dispatch.pc;
-        cpu->godzilla.pd = cpu->rename_dispatch.pd;
-        cpu->godzilla.ps1 = cpu->rename_dispatch.ps1;
-        cpu->godzilla.ps2 = cpu->rename_dispatch.ps2;
-        cpu->godzilla.rd = cpu->rename_dispatch.rd;
-        cpu->godzilla.rs1 = cpu->rename_dispatch.rs1;
-        cpu->godzilla.rs2 = cpu->rename_dispatch.rs2;
-        cpu->godzilla.has_insn = TRUE;
-
-        switch (cpu->rename_dispatch.opcode) {
-            case OPCODE_ADD:
-            case OPCODE_SUB:
-            case OPCODE_MUL:
-            case OPCODE_AND:
-            case OPCODE_OR:
-            case OPCODE_XOR:
-            case OPCODE_STORE:
-            case OPCODE_CMP:
-            {
-                if (cpu->cpu_prf[cpu->rename_dispatch.ps1].isValid || 
-                    cpu->rename_dispatch.ps1 == cpu->intFU_broadcasted_tag || 
-                    cpu->rename_dispatch.ps1 == cpu->mulFU_broadcasted_tag) {
-                    cpu->godzilla.ps1_valid = TRUE;
-                }
-                else {
-                    cpu->godzilla.ps1_valid = FALSE;
-                }
+/*
+This method is used to take a condition code register from the head of its free list
+*/
+static int allocate_cc_reg (APEX_CPU *cpu) {
+    int reg = cpu->thread->cc_free_list[cpu->thread->cc_free_head];
 
-                if (cpu->cpu_prf[cpu->rename_dispatch.ps2].isValid || 
-                    cpu->rename_dispatch.ps2 == cpu->intFU_broadcasted_tag || 
-                    cpu->rename_dispatch.ps2 == cpu->mulFU_broadcasted_tag) {
-                    cpu->godzilla.ps2_valid = TRUE;
-                }
-                else {
-                    cpu->godzilla.ps2_valid = FALSE;
-                }
+    cpu->thread->cc_free_head = (cpu->thread->cc_free_head + 1) % CPRF_SIZE;
+    cpu->thread->cc_free_count--;
+    cpu->thread->cc_free_allocs++;
 
-                break;
-            }
+    return reg;
+}
+
+/*
+This method is used to return a condition code register to the tail of its free list
+*/
+static void release_cc_reg (APEX_CPU *cpu, int reg) {
+    cpu->thread->cc_free_list[cpu->thread->cc_free_tail] = reg;
+    cpu->thread->cc_free_tail = (cpu->thread->cc_free_tail + 1) % CPRF_SIZE;
+    cpu->thread->cc_free_count++;
+}
+
+/*
+This method returns how many physical registers renaming the instruction in the stage will allocate:
+one per source register read before it was ever written, one for the destination and one for the
+post-incremented base register of LOADP/STOREP
+*/
+static int free_regs_needed (const APEX_CPU *cpu, const CPU_Stage *stage) {
+    int needed = 0;
+    int reads_rs1 = FALSE;
+    int reads_rs2 = FALSE;
+
+    switch (stage->opcode)
+    {
+        case OPCODE_ADD:
+        case OPCODE_SUB:
+        case OPCODE_MUL:
+        case OPCODE_DIV:
+        case OPCODE_AND:
+        case OPCODE_OR:
+        case OPCODE_XOR:
+        case OPCODE_STORE:
+        case OPCODE_STOREP:
+        case OPCODE_CMP:
+            reads_rs1 = TRUE;
+            reads_rs2 = TRUE;
+            break;
+
+        case OPCODE_LOAD:
+        case OPCODE_LOADP:
+        case OPCODE_ADDL:
+        case OPCODE_SUBL:
+        case OPCODE_JALR:
+        case OPCODE_JUMP:
+        case OPCODE_CML:
+            reads_rs1 = TRUE;
+            break;
+    }
+
+    if (reads_rs1 && cpu->thread->rename_table[stage->rs1] == -1) {
+        needed++;
+    }
+    if (reads_rs2 && cpu->thread->rename_table[stage->rs2] == -1 && !(reads_rs1 && stage->rs2 == stage->rs1)) {
+        needed++;
+    }
+
+    switch (stage->opcode)
+    {
+        case OPCODE_ADD:
+        case OPCODE_ADDL:
+        case OPCODE_SUB:
+        case OPCODE_SUBL:
+        case OPCODE_MUL:
+        case OPCODE_DIV:
+        case OPCODE_AND:
+        case OPCODE_OR:
+        case OPCODE_XOR:
+        case OPCODE_LOAD:
+        case OPCODE_MOVC:
+        case OPCODE_JALR:
+        case OPCODE_STOREP:
+            needed += 1;
+            break;
+
+        case OPCODE_LOADP:
+            needed += 2;
+            break;
+    }
+
+    return needed;
+}
+
+/*
+This method returns how many condition code registers renaming the instruction in the stage will
+allocate: one for a flag-producing instruction, one for a branch reading flags never written
+*/
+static int cc_regs_needed (const APEX_CPU *cpu, const CPU_Stage *stage) {
+    if (insn_sets_flags(stage->opcode)) {
+        return 1;
+    }
+
+    if (is_conditional_branch(stage->opcode) && cpu->thread->cc_rename == -1) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+This method returns the index of a free rename checkpoint, -1 if every one holds an unresolved branch
+*/
+static int free_checkpoint (const APEX_CPU *cpu) {
+    for (int i = 0; i < CHECKPOINT_COUNT; i++) {
+        if (!cpu->thread->checkpoints[i].isValid) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+This method saves the rename state as it stands after renaming the branch in the stage, along with the
+return-address stack as fetch left it after the branch. Returns the checkpoint taken.
+*/
+static int take_checkpoint (APEX_CPU *cpu, const CPU_Stage *stage) {
+    int i = free_checkpoint(cpu);
+    Rename_Checkpoint *checkpoint = &cpu->thread->checkpoints[i];
+
+    memcpy(checkpoint->rename_table, cpu->thread->rename_table, sizeof(checkpoint->rename_table));
+    memset(checkpoint->allocated, 0, sizeof(checkpoint->allocated));
+    memset(checkpoint->shared, 0, sizeof(checkpoint->shared));
+    checkpoint->cc_rename = cpu->thread->cc_rename;
+    checkpoint->cc_free_head = cpu->thread->cc_free_head;
+    checkpoint->cc_free_allocs = cpu->thread->cc_free_allocs;
+    checkpoint->ras_state = stage->ras_state;
+    checkpoint->seq = stage->seq;
+    checkpoint->isValid = TRUE;
+
+    return i;
+}
+
+/*
+This method returns TRUE if renaming the instruction in the stage has to wait for free physical or
+condition code registers, or for a free checkpoint if it is a branch
+*/
+static int rename_needs_stall (const APEX_CPU *cpu, const CPU_Stage *stage) {
+    return cpu->free_reg_count < free_regs_needed(cpu, stage) || cpu->thread->cc_free_count < cc_regs_needed(cpu, stage) ||
+           (is_branch(stage->opcode) && free_checkpoint(cpu) == -1);
+}
+
+#if RENAME_ELIMINATION
+/*
+This method renames the destination of the instruction in the stage without giving its result to an FU
+to compute, and returns TRUE, when the result is known at rename:
+- AND/OR of a register with itself, and ADDL/SUBL #0, are moves: rd is mapped onto the physical register
+  of the source
+- MOVC, and XOR/SUB of a register with itself, are constants written to a new physical register
+The stage is marked eliminated, with the result left in result_buffer for the flags, unless it is a move
+whose source is not ready yet: that one still goes to the INT FU, for its flags only. Returns FALSE for
+every other instruction.
+*/
+static int eliminate_at_rename (APEX_CPU *cpu, CPU_Stage *stage) {
+    int is_move = FALSE;
+    int value = 0;
+
+    switch (stage->opcode) {
+        case OPCODE_MOVC:
+            value = stage->imm;
+            break;
+
+        case OPCODE_XOR:
+        case OPCODE_SUB:
+            if (stage->rs1 != stage->rs2) {
+                return FALSE;
+            }
+            value = 0;
+            break;
+
+        case OPCODE_AND:
+        case OPCODE_OR:
+            if (stage->rs1 != stage->rs2) {
+                return FALSE;
+            }
+            is_move = TRUE;
+            break;
+
+        case OPCODE_ADDL:
+        case OPCODE_SUBL:
+            if (stage->imm != 0) {
+                return FALSE;
+            }
+            is_move = TRUE;
+            break;
+
+        default:
+            return FALSE;
+    }
+
+    stage->overwritten_pd = cpu->thread->rename_table[stage->rd];
+    if (is_move) {
+        stage->pd = stage->ps1;
+        share_phys_reg(cpu, stage->pd);
+        stage->eliminated = cpu->cpu_prf[stage->ps1].isValid;
+        if (stage->eliminated) {
+            value = cpu->cpu_prf[stage->ps1].value;
+        }
+        cpu->stats.moves_eliminated++;
+    }
+    else {
+        stage->pd = allocate_phys_reg(cpu);
+        cpu->cpu_prf[stage->pd].value = value;
+        cpu->cpu_prf[stage->pd].isValid = TRUE;
+        stage->eliminated = TRUE;
+        cpu->stats.consts_materialized++;
+    }
+    cpu->thread->rename_table[stage->rd] = stage->pd;
+    stage->result_buffer = value;
+
+    return TRUE;
+}
+#endif
+
+#if MACRO_OP_FUSION
+/*
+This method returns TRUE if the next instruction can be fused behind the one in the stage: a CMP/CML
+followed by a conditional branch on its flags, or a MOVC followed by an ADD/SUB/MUL reading its register
+*/
+static int is_fusible_pair (const CPU_Stage *stage, const CPU_Stage *next) {
+    switch (stage->opcode) {
+        case OPCODE_CMP:
+        case OPCODE_CML:
+            return is_conditional_branch(next->opcode);
+
+        case OPCODE_MOVC:
+            switch (next->opcode) {
+                case OPCODE_ADD:
+                case OPCODE_SUB:
+                case OPCODE_MUL:
+                    return next->rs1 == stage->rd || next->rs2 == stage->rd;
+            }
+            break;
+    }
+
+    return FALSE;
+}
+
+/*
+This method fuses into the instruction in the stage the one waiting behind it in the fetch buffer, when the
+two make a fusible pair and the free lists can rename both. Fetch filled the buffer in an earlier cycle, while
+decode was held, so a pair never costs more than its two fetch slots. The pair goes on as a single instruction
+that keeps the pc and sequence number of the first:
+- CMP/CML + branch stays a CMP/CML that also resolves the branch at pc + 4 on the flags it computes
+- MOVC + ADD/SUB/MUL becomes the ADD/SUB/MUL, with the MOVC as a second destination written at rename
+*/
+static void fuse_next_insn (APEX_CPU *cpu, CPU_Stage *stage) {
+    CPU_Stage *next = &cpu->thread->fetch_buffer;
+
+    if (!next->has_insn || next->pc != stage->pc + 4 || !is_fusible_pair(stage, next)) {
+        return;
+    }
+
+    if (cpu->free_reg_count < free_regs_needed(cpu, stage) + free_regs_needed(cpu, next) ||
+        cpu->thread->cc_free_count < cc_regs_needed(cpu, stage) + cc_regs_needed(cpu, next) ||
+        (is_branch(next->opcode) && free_checkpoint(cpu) == -1)) {
+        return;
+    }
+
+    if (stage->opcode == OPCODE_MOVC) {
+        stage->fused_rd = stage->rd;
+        stage->fused_imm = stage->imm;
+        strcpy(stage->opcode_str, next->opcode_str);
+        stage->opcode = next->opcode;
+        stage->rd = next->rd;
+        stage->rs1 = next->rs1;
+        stage->rs2 = next->rs2;
+        stage->imm = next->imm;
+        stage->fused_opcode = OPCODE_MOVC;
+    }
+    else {
+        stage->fused_opcode = next->opcode;
+        stage->fused_imm = next->imm;
+    }
+
+    stage->fused_seq = next->seq;
+    stage->pred_target = next->pred_target;
+    stage->ras_state = next->ras_state;
+    next->has_insn = FALSE;
+}
+#endif
+
+static void
+APEX_Decode(APEX_CPU *cpu)
+{
+    int rd_renamed = FALSE;
+
+    if(cpu->thread->decode_rename.has_insn)
+    {
+        /* Hold the instruction while dispatch has not consumed the previous one, while the free lists
+           cannot cover every register this instruction allocates, or while a branch finds no free checkpoint */
+        if (cpu->thread->rename_dispatch.has_insn || rename_needs_stall(cpu, &cpu->thread->decode_rename))
+        {
+            return;
+        }
+
+#if MACRO_OP_FUSION
+        fuse_next_insn(cpu, &cpu->thread->decode_rename);
+#endif
+
+        cpu->thread->decode_rename.pd = -1;
+        cpu->thread->decode_rename.overwritten_pd = -1;
+        cpu->thread->decode_rename.lpsp_overwritten_pd = -1;
+        cpu->thread->decode_rename.cc_pd = -1;
+        cpu->thread->decode_rename.cc_overwritten_pd = -1;
+        cpu->thread->decode_rename.cc_ps = -1;
+        cpu->thread->decode_rename.fused_pd = -1;
+        cpu->thread->decode_rename.fused_overwritten_pd = -1;
+
+        /* A MOVC fused ahead of the instruction is renamed first, its constant is ready for the instruction to read */
+        if (cpu->thread->decode_rename.fused_opcode == OPCODE_MOVC)
+        {
+            cpu->thread->decode_rename.fused_overwritten_pd = cpu->thread->rename_table[cpu->thread->decode_rename.fused_rd];
+            cpu->thread->decode_rename.fused_pd = allocate_phys_reg(cpu);
+            cpu->thread->rename_table[cpu->thread->decode_rename.fused_rd] = cpu->thread->decode_rename.fused_pd;
+            cpu->cpu_prf[cpu->thread->decode_rename.fused_pd].value = cpu->thread->decode_rename.fused_imm;
+            cpu->cpu_prf[cpu->thread->decode_rename.fused_pd].isValid = TRUE;
+        }
+
+        // rs1 & rs2 renaming
+        switch (cpu->thread->decode_rename.opcode)
+        {
+            case OPCODE_ADD:
+            case OPCODE_SUB:
+            case OPCODE_MUL:
+            case OPCODE_DIV:
+            case OPCODE_AND:
+            case OPCODE_OR:
+            case OPCODE_XOR:
+            case OPCODE_STORE:
+            case OPCODE_STOREP:
+            case OPCODE_CMP:
+            {
+                if(cpu->thread->rename_table[cpu->thread->decode_rename.rs1] == -1)
+                {
+                    cpu->thread->decode_rename.ps1 = allocate_phys_reg(cpu);
+                    cpu->thread->rename_table[cpu->thread->decode_rename.rs1] = cpu->thread->decode_rename.ps1;
+                    /* First read of a never-written register: architectural registers start at zero */
+                    cpu->cpu_prf[cpu->thread->decode_rename.ps1].value = 0;
+                    cpu->cpu_prf[cpu->thread->decode_rename.ps1].isValid = TRUE;
+                    cpu->cpu_prf[cpu->thread->decode_rename.ps1].pending_retires = 0;
+                }
+                else {
+                    cpu->thread->decode_rename.ps1 = cpu->thread->rename_table[cpu->thread->decode_rename.rs1];
+                }
+                
+                if(cpu->thread->rename_table[cpu->thread->decode_rename.rs2] == -1)
+                {
+                    cpu->thread->decode_rename.ps2 = allocate_phys_reg(cpu);
+                    cpu->thread->rename_table[cpu->thread->decode_rename.rs2] = cpu->thread->decode_rename.ps2;
+                    /* First read of a never-written register: architectural registers start at zero */
+                    cpu->cpu_prf[cpu->thread->decode_rename.ps2].value = 0;
+                    cpu->cpu_prf[cpu->thread->decode_rename.ps2].isValid = TRUE;
+                    cpu->cpu_prf[cpu->thread->decode_rename.ps2].pending_retires = 0;
+                }
+                else {
+                    cpu->thread->decode_rename.ps2 = cpu->thread->rename_table[cpu->thread->decode_rename.rs2];
+                }
+
+                break;
+            }
+
+            case OPCODE_LOAD:
+            case OPCODE_LOADP:
+            case OPCODE_ADDL:
+            case OPCODE_SUBL:
+            case OPCODE_JALR:
+            case OPCODE_JUMP:
+            case OPCODE_CML:
+            {
+                if(cpu->thread->rename_table[cpu->thread->decode_rename.rs1] == -1)
+                {
+                    cpu->thread->decode_rename.ps1 = allocate_phys_reg(cpu);
+                    cpu->thread->rename_table[cpu->thread->decode_rename.rs1] = cpu->thread->decode_rename.ps1;
+                    /* First read of a never-written register: architectural registers start at zero */
+                    cpu->cpu_prf[cpu->thread->decode_rename.ps1].value = 0;
+                    cpu->cpu_prf[cpu->thread->decode_rename.ps1].isValid = TRUE;
+                    cpu->cpu_prf[cpu->thread->decode_rename.ps1].pending_retires = 0;
+                }
+                else {
+                    cpu->thread->decode_rename.ps1 = cpu->thread->rename_table[cpu->thread->decode_rename.rs1];
+                }
+                break;
+            }
+
+            case OPCODE_MOVC:
+            case OPCODE_NOP:
+            {
+                cpu->thread->decode_rename.ps1 = -2;
+                cpu->thread->decode_rename.ps2 = -2;
+                break;
+            }
+
+            case OPCODE_HALT:
+            {
+                cpu->thread->decode_rename.ps1 = -2;
+                cpu->thread->decode_rename.ps2 = -2;
+                cpu->thread->fetch.has_insn = FALSE;
+                break;
+            }
+
+        
+            default:
+                break;
+        }
+        
+        // rd renaming
+        cpu->thread->decode_rename.eliminated = FALSE;
+#if RENAME_ELIMINATION
+        rd_renamed = eliminate_at_rename(cpu, &cpu->thread->decode_rename);
+#endif
+
+        if (!rd_renamed)
+        {
+            switch (cpu->thread->decode_rename.opcode)
+            {
+                case OPCODE_ADD:
+                case OPCODE_ADDL:
+                case OPCODE_SUB:
+                case OPCODE_SUBL:
+                case OPCODE_MUL:
+                case OPCODE_DIV:
+                case OPCODE_AND:
+                case OPCODE_OR:
+                case OPCODE_XOR:
+                case OPCODE_LOAD:
+                case OPCODE_MOVC:
+                case OPCODE_JALR:
+                {
+                    cpu->thread->decode_rename.overwritten_pd = cpu->thread->rename_table[cpu->thread->decode_rename.rd];
+                    cpu->thread->decode_rename.pd = allocate_phys_reg(cpu);
+                    cpu->thread->rename_table[cpu->thread->decode_rename.rd] = cpu->thread->decode_rename.pd;
+                    cpu->cpu_prf[cpu->thread->decode_rename.pd].isValid = FALSE;
+                    break;
+                }
+
+                case OPCODE_LOADP:
+                {
+                    cpu->thread->decode_rename.overwritten_pd = cpu->thread->rename_table[cpu->thread->decode_rename.rd];
+                    cpu->thread->decode_rename.pd = allocate_phys_reg(cpu);
+                    cpu->thread->rename_table[cpu->thread->decode_rename.rd] = cpu->thread->decode_rename.pd;
+                    cpu->cpu_prf[cpu->thread->decode_rename.pd].isValid = FALSE;
+
+                    cpu->thread->decode_rename.lpsp_overwritten_pd = cpu->thread->rename_table[cpu->thread->decode_rename.rs1];
+                    cpu->thread->decode_rename.lpsp_inc_dest = allocate_phys_reg(cpu);
+                    cpu->thread->rename_table[cpu->thread->decode_rename.rs1] = cpu->thread->decode_rename.lpsp_inc_dest;
+                    cpu->cpu_prf[cpu->thread->decode_rename.lpsp_inc_dest].isValid = FALSE;
+                    break;
+                }
+
+                case OPCODE_STOREP:
+                {
+                    cpu->thread->decode_rename.lpsp_overwritten_pd = cpu->thread->rename_table[cpu->thread->decode_rename.rs2];
+                    cpu->thread->decode_rename.lpsp_inc_dest = allocate_phys_reg(cpu);
+                    cpu->thread->rename_table[cpu->thread->decode_rename.rs2] = cpu->thread->decode_rename.lpsp_inc_dest;
+                    cpu->cpu_prf[cpu->thread->decode_rename.lpsp_inc_dest].isValid = FALSE;
+                    break;
+                }
+            }
+        }
+
+        // condition code renaming
+        if (is_conditional_branch(cpu->thread->decode_rename.opcode))
+        {
+            if (cpu->thread->cc_rename == -1)
+            {
+                cpu->thread->cc_rename = allocate_cc_reg(cpu);
+                /* Flags read before any instruction set them start cleared */
+                cpu->cpu_cprf[cpu->thread->cc_rename].value = 0;
+                cpu->cpu_cprf[cpu->thread->cc_rename].isValid = TRUE;
+            }
+
+            cpu->thread->decode_rename.cc_ps = cpu->thread->cc_rename;
+            cpu->thread->decode_rename.ps1 = CC_TAG(cpu->thread->cc_rename);
+            cpu->thread->decode_rename.ps2 = -2;
+        }
+        else if (insn_sets_flags(cpu->thread->decode_rename.opcode))
+        {
+            cpu->thread->decode_rename.cc_overwritten_pd = cpu->thread->cc_rename;
+            cpu->thread->decode_rename.cc_pd = allocate_cc_reg(cpu);
+            cpu->thread->cc_rename = cpu->thread->decode_rename.cc_pd;
+            cpu->cpu_cprf[cpu->thread->decode_rename.cc_pd].isValid = FALSE;
+
+            if (cpu->thread->decode_rename.eliminated) {
+                cpu->cpu_cprf[cpu->thread->decode_rename.cc_pd].value = result_flags(cpu->thread->decode_rename.result_buffer);
+                cpu->cpu_cprf[cpu->thread->decode_rename.cc_pd].isValid = TRUE;
+            }
+        }
+
+        cpu->thread->decode_rename.checkpoint = -1;
+        if (is_branch(cpu->thread->decode_rename.opcode) || is_branch(cpu->thread->decode_rename.fused_opcode))
+        {
+            cpu->thread->decode_rename.checkpoint = take_checkpoint(cpu, &cpu->thread->decode_rename);
+        }
+#if LOAD_VALUE_PREDICTION
+        /* A load is only predicted when a checkpoint is left to flush back to, it never waits for one */
+        else if ((cpu->thread->decode_rename.opcode == OPCODE_LOAD || cpu->thread->decode_rename.opcode == OPCODE_LOADP) &&
+                 value_predictor_predict(&cpu->thread->value_pred, cpu->thread->decode_rename.pc, &cpu->thread->decode_rename.pred_value) &&
+                 free_checkpoint(cpu) != -1)
+        {
+            cpu->thread->decode_rename.checkpoint = take_checkpoint(cpu, &cpu->thread->decode_rename);
+        }
+#endif
+
+        if (cpu->debug_messages)
+        {
+            printf("\nRename Table: \n");
+            for (int i = 0; i < REG_FILE_SIZE; i++) {
+                printf("%d => %d\n", i, cpu->thread->rename_table[i]);
+            }
+            printf("\nFree list of registers: \n");
+            for (int i = bitset_next(cpu->free_regs, PRF_WORDS, 0); i != -1; i = bitset_next(cpu->free_regs, PRF_WORDS, i + 1)) {
+                printf("%d\t", i);
+            }
+            printf("\n\n");
+        }
+
+        cpu->thread->rename_dispatch = cpu->thread->decode_rename;
+        cpu->thread->rename_dispatch.has_insn = TRUE;
+        trace_stage(cpu, cpu->thread->rename_dispatch.seq, PIPEVIEW_DECODE);
+        if (cpu->debug_messages)
+        {
+            print_stage_content("Decode1", &cpu->thread->decode_rename);
+        }        
+        cpu->thread->decode_rename.has_insn = FALSE;
+        
+    }
+
+    /* The instruction fetched while decode was held moves up */
+    if (!cpu->thread->decode_rename.has_insn && cpu->thread->fetch_buffer.has_insn)
+    {
+        cpu->thread->decode_rename = cpu->thread->fetch_buffer;
+        cpu->thread->fetch_buffer.has_insn = FALSE;
+    }
+}
+
+static int
+APEX_Dispatch(APEX_CPU *cpu)
+{
+    if(cpu->thread->rename_dispatch.has_insn)
+    {
+        /* Hold the instruction while the IQ, ROB or LSQ is full */
+        if(cpu->thread->godzilla.enter_godzilla == FALSE)
+        {
+            return FALSE;
+        }
+
+        cpu->thread->godzilla.imm = cpu->thread->rename_dispatch.imm;
+        cpu->thread->godzilla.opcode = cpu->thread->rename_dispatch.opcode;
+        strcpy(cpu->thread->godzilla.opcode_str, cpu->thread->rename_dispatch.opcode_str);
+        cpu->thread->godzilla.overwritten_pd = cpu->thread->rename_dispatch.overwritten_pd;
+        cpu->thread->godzilla.lpsp_overwritten_pd = cpu->thread->rename_dispatch.lpsp_overwritten_pd;
+        cpu->thread->godzilla.pc = cpu->thread->rename_dispatch.pc;
+        cpu->thread->godzilla.pd = cpu->thread->rename_dispatch.pd;
+        cpu->thread->godzilla.ps1 = cpu->thread->rename_dispatch.ps1;
+        cpu->thread->godzilla.ps2 = cpu->thread->rename_dispatch.ps2;
+        cpu->thread->godzilla.rd = cpu->thread->rename_dispatch.rd;
+        cpu->thread->godzilla.rs1 = cpu->thread->rename_dispatch.rs1;
+        cpu->thread->godzilla.rs2 = cpu->thread->rename_dispatch.rs2;
+        cpu->thread->godzilla.seq = cpu->thread->rename_dispatch.seq;
+        cpu->thread->godzilla.cc_pd = cpu->thread->rename_dispatch.cc_pd;
+        cpu->thread->godzilla.cc_overwritten_pd = cpu->thread->rename_dispatch.cc_overwritten_pd;
+        cpu->thread->godzilla.cc_ps = cpu->thread->rename_dispatch.cc_ps;
+        cpu->thread->godzilla.pred_target = cpu->thread->rename_dispatch.pred_target;
+        cpu->thread->godzilla.pred_source = cpu->thread->rename_dispatch.pred_source;
+        cpu->thread->godzilla.checkpoint = cpu->thread->rename_dispatch.checkpoint;
+        cpu->thread->godzilla.pred_value = cpu->thread->rename_dispatch.pred_value;
+        cpu->thread->godzilla.eliminated = cpu->thread->rename_dispatch.eliminated;
+        cpu->thread->godzilla.fused_opcode = cpu->thread->rename_dispatch.fused_opcode;
+        cpu->thread->godzilla.fused_imm = cpu->thread->rename_dispatch.fused_imm;
+        cpu->thread->godzilla.fused_rd = cpu->thread->rename_dispatch.fused_rd;
+        cpu->thread->godzilla.fused_pd = cpu->thread->rename_dispatch.fused_pd;
+        cpu->thread->godzilla.fused_overwritten_pd = cpu->thread->rename_dispatch.fused_overwritten_pd;
+        cpu->thread->godzilla.fused_seq = cpu->thread->rename_dispatch.fused_seq;
+        cpu->thread->godzilla.has_insn = TRUE;
+        trace_stage(cpu, cpu->thread->godzilla.seq, PIPEVIEW_RENAME);
+        cpu->thread->godzilla.insn_pending = TRUE;
+        cpu->thread->rename_dispatch.has_insn = FALSE;
+
+        switch (cpu->thread->rename_dispatch.opcode) {
+            case OPCODE_ADD:
+            case OPCODE_SUB:
+            case OPCODE_MUL:
+            case OPCODE_DIV:
+            case OPCODE_AND:
+            case OPCODE_OR:
+            case OPCODE_XOR:
+            case OPCODE_STORE:
+            case OPCODE_CMP:
+            {
+                if (cpu->cpu_prf[cpu->thread->rename_dispatch.ps1].isValid || 
+                    cpu->thread->rename_dispatch.ps1 == cpu->intFU_broadcasted_tag || 
+                    cpu->thread->rename_dispatch.ps1 == cpu->mulFU_broadcasted_tag) {
+                    cpu->thread->godzilla.ps1_valid = TRUE;
+                }
+                else {
+                    cpu->thread->godzilla.ps1_valid = FALSE;
+                }
+
+                if (cpu->cpu_prf[cpu->thread->rename_dispatch.ps2].isValid || 
+                    cpu->thread->rename_dispatch.ps2 == cpu->intFU_broadcasted_tag || 
+                    cpu->thread->rename_dispatch.ps2 == cpu->mulFU_broadcasted_tag) {
+                    cpu->thread->godzilla.ps2_valid = TRUE;
+                }
+                else {
+                    cpu->thread->godzilla.ps2_valid = FALSE;
+                }
+
+                break;
+            }
+
+            case OPCODE_STOREP:
+            {
+                // printf("\nSTOREP: ps1-valid: %d, broadcast = %d\n", cpu->cpu_prf[cpu->thread->rename_dispatch.ps1].isValid, cpu->intFU_broadcasted_tag);
+                if (cpu->cpu_prf[cpu->thread->rename_dispatch.ps1].isValid || 
+                    cpu->thread->rename_dispatch.ps1 == cpu->intFU_broadcasted_tag || 
+                    cpu->thread->rename_dispatch.ps1 == cpu->mulFU_broadcasted_tag) {
+                    cpu->thread->godzilla.ps1_valid = TRUE;
+                }
+                else {
+                    cpu->thread->godzilla.ps1_valid = FALSE;
+                }
+
+                if (cpu->cpu_prf[cpu->thread->rename_dispatch.ps2].isValid || 
+                    cpu->thread->rename_dispatch.ps2 == cpu->intFU_broadcasted_tag || 
+                    cpu->thread->rename_dispatch.ps2 == cpu->mulFU_broadcasted_tag) {
+                    cpu->thread->godzilla.ps2_valid = TRUE;
+                }
+                else {
+                    cpu->thread->godzilla.ps2_valid = FALSE;
+                }
+
+                if (cpu->debug_messages) {
+                    printf("\nlpsp_inc_dest in rename_dispatch = %d\n", cpu->thread->rename_dispatch.lpsp_inc_dest);
+                }
+                cpu->thread->godzilla.lpsp_inc_dest = cpu->thread->rename_dispatch.lpsp_inc_dest;
+
+                break;
+            }
+
+            case OPCODE_LOAD:
+            case OPCODE_ADDL:
+            case OPCODE_SUBL:
+            case OPCODE_CML:
+            case OPCODE_JUMP:
+            case OPCODE_JALR:
+            {
+                if (cpu->cpu_prf[cpu->thread->rename_dispatch.ps1].isValid || 
+                    cpu->thread->rename_dispatch.ps1 == cpu->intFU_broadcasted_tag || 
+                    cpu->thread->rename_dispatch.ps1 == cpu->mulFU_broadcasted_tag) {
+                    cpu->thread->godzilla.ps1_valid = TRUE;
+                }
+                else {
+                    cpu->thread->godzilla.ps1_valid = FALSE;
+                }
+
+                cpu->thread->godzilla.ps2_valid = TRUE;
+
+                break;
+            }
+
+            case OPCODE_LOADP:
+            {
+                if (cpu->cpu_prf[cpu->thread->rename_dispatch.ps1].isValid || 
+                    cpu->thread->rename_dispatch.ps1 == cpu->intFU_broadcasted_tag || 
+                    cpu->thread->rename_dispatch.ps1 == cpu->mulFU_broadcasted_tag) {
+                    cpu->thread->godzilla.ps1_valid = TRUE;
+                }
+                else {
+                    cpu->thread->godzilla.ps1_valid = FALSE;
+                }
+
+                cpu->thread->godzilla.ps2_valid = TRUE;
+
+                cpu->thread->godzilla.lpsp_inc_dest = cpu->thread->rename_dispatch.lpsp_inc_dest;
+
+                break;
+            }
+
+            case OPCODE_MOVC:
+            {
+                cpu->thread->godzilla.ps1_valid = TRUE;
+                cpu->thread->godzilla.ps2_valid = TRUE;
+
+                break;
+            }
+
+            case OPCODE_BZ:
+            case OPCODE_BNZ:
+            case OPCODE_BP:
+            case OPCODE_BNP:
+            case OPCODE_BN:
+            case OPCODE_BNN:
+            {
+                cpu->thread->godzilla.ps1_valid = cpu->cpu_cprf[cpu->thread->rename_dispatch.cc_ps].isValid;
+                cpu->thread->godzilla.ps2_valid = TRUE;
+
+                break;
+            }
+        }
+
+        if(cpu->thread->rename_dispatch.opcode == OPCODE_HALT)
+        {
+            cpu->thread->godzilla.ps1_valid = TRUE;
+            cpu->thread->godzilla.ps2_valid = TRUE;
+        }
+
+        if (cpu->debug_messages)
+        {
+            print_stage_content("Decode2", &cpu->thread->rename_dispatch);
+        }
+    }
+
+    return FALSE;
+}
+
+#pragma region - Godzilla Stage 
+
+/*
+This method returns the number of entries of a circular queue between head and tail
+*/
+static int queue_occupancy (int head, int tail, int head_valid, int size) {
+    if (head == tail) {
+        return head_valid ? size : 0;
+    }
+
+    return (tail - head + size) % size;
+}
+
+/*
+This method returns the number of ROB entries the thread holds
+*/
+static int thread_rob_occupancy (const APEX_Thread *thread) {
+    return queue_occupancy(thread->rob_head, thread->rob_tail, thread->cpu_rob[thread->rob_head].isValid, ROB_SIZE);
+}
+
+/*
+This method returns the number of LSQ entries the thread holds
+*/
+static int thread_lsq_occupancy (const APEX_Thread *thread) {
+    return queue_occupancy(thread->lsq_head, thread->lsq_tail, thread->cpu_lsq[thread->lsq_head].isValid, LSQ_SIZE);
+}
+
+/*
+This method returns TRUE if the ROB or the LSQ, of size entries, has no entry left for the thread. With
+SMT_QUEUES_PARTITIONED every thread owns an equal share of the entries, with SMT_QUEUES_SHARED the
+threads take them from one pool.
+*/
+static int thread_queue_full (const APEX_CPU *cpu, int (*occupancy)(const APEX_Thread *), int size) {
+    int used = 0;
+
+    if (cpu->queue_policy == SMT_QUEUES_PARTITIONED) {
+        return occupancy(cpu->thread) >= size / cpu->thread_count;
+    }
+
+    for (int t = 0; t < cpu->thread_count; t++) {
+        used += occupancy(&cpu->threads[t]);
+    }
+
+    return used >= size;
+}
+
+/*
+This method sets the flag enter_godzilla to denote if dispatch should stall
+*/
+void should_dispatch_stall (APEX_CPU *cpu) {
+    int entry_available_in_iq = 0;
+    int entry_available_in_rob = 0;
+    int entry_available_in_lsq = 0;
+    int entry_available_in_bq = 0;
+    int entry_available_in_bis = 0;
+
+    if (bitset_next(cpu->iq_sched.free, IQ_WORDS, 0) != -1) {
+        entry_available_in_iq = 1;
+    }
+
+    if (entry_available_in_iq == 0) {
+        cpu->thread->godzilla.enter_godzilla = FALSE;
+        cpu->thread->godzilla.stall_cause = STALL_IQ_FULL;
+        return;
+    }
+
+    if (thread_queue_full(cpu, thread_rob_occupancy, ROB_SIZE)) {
+        cpu->thread->godzilla.enter_godzilla = FALSE;
+        cpu->thread->godzilla.stall_cause = STALL_ROB_FULL;
+        return;
+    }
+
+    // for (int i = 0; i < ROB_SIZE; i++) {
+    //     if (cpu->thread->cpu_rob[i].isValid != TRUE) {
+    //         entry_available_in_rob = 1;
+    //         break;
+    //     }
+    // }
+
+    // if (entry_available_in_rob == 0) {
+    //     cpu->thread->godzilla.enter_godzilla = FALSE;
+    //     return;
+    // }
+
+    if (cpu->thread->rename_dispatch.opcode == OPCODE_LOAD || 
+        cpu->thread->rename_dispatch.opcode == OPCODE_STORE || 
+        cpu->thread->rename_dispatch.opcode == OPCODE_LOADP || 
+        cpu->thread->rename_dispatch.opcode == OPCODE_STOREP) {
+        if (thread_queue_full(cpu, thread_lsq_occupancy, LSQ_SIZE)) {
+            cpu->thread->godzilla.enter_godzilla = FALSE;
+            cpu->thread->godzilla.stall_cause = STALL_LSQ_FULL;
+            return;
+        }
+        // for (int i = 0; i < LSQ_SIZE; i++) {
+        //     if (cpu->thread->cpu_lsq[i].isValid != TRUE) {
+        //         entry_available_in_lsq = 1;
+        //         break;
+        //     }
+        // }
+
+        // if (entry_available_in_lsq == 0) {
+        //     cpu->thread->godzilla.enter_godzilla = FALSE;
+        //     return;
+        // }
+    }
+
+    if (cpu->thread->rename_dispatch.opcode == OPCODE_BNP || 
+        cpu->thread->rename_dispatch.opcode == OPCODE_BNZ || 
+        cpu->thread->rename_dispatch.opcode == OPCODE_BP || 
+        cpu->thread->rename_dispatch.opcode == OPCODE_BZ || 
+        cpu->thread->rename_dispatch.opcode == OPCODE_JUMP || 
+        cpu->thread->rename_dispatch.opcode == OPCODE_JALR) {
+            // Yet to implement for branch instructions
+    }
+
+    cpu->thread->godzilla.enter_godzilla = TRUE;
+    cpu->thread->godzilla.stall_cause = STALL_NONE;
+    if (cpu->thread->godzilla.opcode == OPCODE_HALT)
+    {
+        cpu->thread->godzilla.enter_godzilla = FALSE;
+        cpu->thread->godzilla.stall_cause = STALL_HALT;
+    }
+}
+
+/*
+This method is used to setup an entry in the LSQ
+*/
+void setup_entry_in_lsq (APEX_CPU *cpu) {
+    cpu->thread->cpu_lsq[cpu->thread->lsq_tail].dest = cpu->thread->godzilla.pd;
+    cpu->thread->cpu_lsq[cpu->thread->lsq_tail].mem_valid = FALSE;
+    cpu->thread->cpu_lsq[cpu->thread->lsq_tail].lORs = (cpu->thread->godzilla.opcode == OPCODE_LOAD || cpu->thread->godzilla.opcode == OPCODE_LOADP) ? 1 : 0;
+    cpu->thread->cpu_lsq[cpu->thread->lsq_tail].ps1_tag = cpu->thread->godzilla.ps1;
+    cpu->thread->lsq_ps1_tag[cpu->thread->lsq_tail] = cpu->thread->godzilla.ps1;
+    cpu->thread->cpu_lsq[cpu->thread->lsq_tail].ps1_valid = cpu->thread->godzilla.ps1_valid;
+    cpu->thread->cpu_lsq[cpu->thread->lsq_tail].ps2_tag = cpu->thread->godzilla.ps2;
+    cpu->thread->cpu_lsq[cpu->thread->lsq_tail].ps2_valid = cpu->thread->godzilla.ps2_valid;
+    cpu->thread->cpu_lsq[cpu->thread->lsq_tail].pd = cpu->thread->godzilla.pd;
+    cpu->thread->cpu_lsq[cpu->thread->lsq_tail].isValid = TRUE;
+    cpu->thread->godzilla.lsq_index = cpu->thread->lsq_tail;
+    cpu->thread->lsq_tail = (cpu->thread->lsq_tail + 1) % LSQ_SIZE;
+}
+
+/*
+This method returns TRUE if the instruction writes its rd register
+*/
+static int insn_writes_rd (int opcode) {
+    switch (opcode) {
+        case OPCODE_ADD:
+        case OPCODE_ADDL:
+        case OPCODE_SUB:
+        case OPCODE_SUBL:
+        case OPCODE_MUL:
+        case OPCODE_DIV:
+        case OPCODE_AND:
+        case OPCODE_OR:
+        case OPCODE_XOR:
+        case OPCODE_MOVC:
+        case OPCODE_LOAD:
+        case OPCODE_LOADP:
+        case OPCODE_JALR:
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+/*
+This method is used to setup an entry in the ROB
+*/
+void setup_entry_in_rob(APEX_CPU *cpu) {
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].overwritten_pd = cpu->thread->godzilla.overwritten_pd;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].pc = cpu->thread->godzilla.pc;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].pd = cpu->thread->godzilla.pd;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].rd = insn_writes_rd(cpu->thread->godzilla.opcode) ? cpu->thread->godzilla.rd : -1;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].lsq_index = cpu->thread->godzilla.lsq_index;
+    // cpu->thread->cpu_rob[cpu->thread->rob_tail].insn_type = cpu->thread->godzilla.lsq_index != -1 ? dest_load_store : 0;
+    if (cpu->thread->godzilla.lsq_index != -1) {
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].insn_type = dest_load_store;
+    }
+    else if (cpu->thread->godzilla.opcode == OPCODE_HALT) {
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].insn_type = dest_halt;
+    }
+    else if (cpu->thread->godzilla.opcode == OPCODE_NOP) {
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].insn_type = dest_none;
+    }
+    else if (is_conditional_branch(cpu->thread->godzilla.opcode) || cpu->thread->godzilla.opcode == OPCODE_JUMP ||
+             is_conditional_branch(cpu->thread->godzilla.fused_opcode)) {
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].insn_type = dest_branch;
+    }
+    else {
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].insn_type = 0;
+    }
+    if (cpu->thread->godzilla.opcode == OPCODE_LOADP) {
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].lpsp_rd = cpu->thread->godzilla.rs1;
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].lpsp_pd = cpu->thread->godzilla.lpsp_inc_dest;
+    }
+    else if (cpu->thread->godzilla.opcode == OPCODE_STOREP) {
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].lpsp_rd = cpu->thread->godzilla.rs2;
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].lpsp_pd = cpu->thread->godzilla.lpsp_inc_dest;
+    }
+    else {
+        cpu->thread->cpu_rob[cpu->thread->rob_tail].lpsp_rd = -1;
+    }
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].lpsp_overwritten_pd = cpu->thread->godzilla.lpsp_overwritten_pd;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].mem_error_codes = MEM_ERROR_NONE;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].seq = cpu->thread->godzilla.seq;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].cc_pd = cpu->thread->godzilla.cc_pd;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].cc_overwritten_pd = cpu->thread->godzilla.cc_overwritten_pd;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].completed = FALSE;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].pred_target = cpu->thread->godzilla.pred_target;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].pred_source = cpu->thread->godzilla.pred_source;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].checkpoint = cpu->thread->godzilla.checkpoint;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].fused = cpu->thread->godzilla.fused_opcode != -1;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].fused_rd = cpu->thread->godzilla.fused_rd;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].fused_pd = cpu->thread->godzilla.fused_pd;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].fused_overwritten_pd = cpu->thread->godzilla.fused_overwritten_pd;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].fused_seq = cpu->thread->godzilla.fused_seq;
+    cpu->thread->cpu_rob[cpu->thread->rob_tail].isValid = TRUE;
+    cpu->thread->godzilla.rob_index = cpu->thread->rob_tail;
+    cpu->thread->rob_tail = (cpu->thread->rob_tail + 1) % ROB_SIZE;
+}
+
+/*
+This method returns TRUE if the physical register or condition code register behind a source tag holds
+its value. Negative tags stand for no source.
+*/
+static int phys_tag_valid (const APEX_CPU *cpu, int tag) {
+    if (tag < 0) {
+        return TRUE;
+    }
+
+    if (tag >= CC_TAG(0)) {
+        return cpu->cpu_cprf[tag - CC_TAG(0)].isValid;
+    }
+
+    return cpu->cpu_prf[tag].isValid;
+}
+
+/*
+This method returns TRUE if a register writing or branch ROB entry has finished executing and can commit
+*/
+static int rob_entry_done (const APEX_CPU *cpu, const CPU_ROB *entry) {
+    if (!entry->isValid) {
+        return FALSE;
+    }
+
+    if (entry->insn_type == dest_branch) {
+        return entry->completed;
+    }
+
+    return (entry->pd == -1 || cpu->cpu_prf[entry->pd].isValid) &&
+           (entry->cc_pd == -1 || cpu->cpu_cprf[entry->cc_pd].isValid);
+}
+
+/*
+This method returns the value of a source register read at issue: from the INT or MUL result bus if
+it is broadcast in this cycle, from the PRF otherwise
+*/
+static int issue_operand_value (const APEX_CPU *cpu, int tag) {
+    if (tag == cpu->intFU_broadcasted_tag) {
+        return cpu->intFU_broadcasted_value;
+    }
+
+    if (tag == cpu->mulFU_broadcasted_tag) {
+        return cpu->mulFU_broadcasted_value;
+    }
+
+    return cpu->cpu_prf[tag].value;
+}
+
+/*
+This method stops the CPU on a divide by zero once the faulting DIV reaches the ROB head. The DIV
+does not retire, so the architectural state is the one before it.
+*/
+static void raise_divide_error (APEX_CPU *cpu) {
+    cpu->halt_cpu = TRUE;
+
+    fprintf(stderr, "APEX_Error: Divide by zero at pc(%d)\n", cpu->thread->cpu_rob[cpu->thread->rob_head].pc);
+}
+
+/*
+This method is used to setup an entry in the IQ
+*/
+void setup_entry_in_iq(APEX_CPU *cpu) {
+    // // printf("Setting up entry in IQ");
+    int i = bitset_next(cpu->iq_sched.free, IQ_WORDS, 0);
+
+    if (i == -1) {
+        return;
+    }
+
+    cpu->cpu_iq[i].dest = cpu->thread->godzilla.pd;
+    if (cpu->debug_messages) {
+        printf("\ngodzilla pd = %d\n", cpu->cpu_iq[i].dest);
+    }
+    cpu->cpu_iq[i].literal = cpu->thread->godzilla.imm;
+    cpu->iq_sched.ps1_tag[i] = cpu->thread->godzilla.ps1;
+    if (phys_tag_valid(cpu, cpu->iq_sched.ps1_tag[i])) {
+        bitset_set(cpu->iq_sched.ps1_ready, i);
+    }
+    else {
+        bitset_assign(cpu->iq_sched.ps1_ready, i, cpu->thread->godzilla.ps1_valid);
+    }
+    // cpu->cpu_iq[i].ps1_valid = cpu->thread->godzilla.ps1_valid;
+    cpu->iq_sched.ps2_tag[i] = cpu->thread->godzilla.ps2;
+    if (phys_tag_valid(cpu, cpu->iq_sched.ps2_tag[i])) {
+        bitset_set(cpu->iq_sched.ps2_ready, i);
+    }
+    else {
+        bitset_assign(cpu->iq_sched.ps2_ready, i, cpu->thread->godzilla.ps2_valid);
+    }
+    // cpu->cpu_iq[i].ps2_valid = cpu->thread->godzilla.ps2_valid;
+    cpu->iq_sched.age[i] = cpu->clock;
+    cpu->cpu_iq[i].function_type = cpu->thread->godzilla.opcode;
+    cpu->cpu_iq[i].seq = cpu->thread->godzilla.seq;
+    cpu->cpu_iq[i].thread = cpu->thread->id;
+    cpu->cpu_iq[i].cc_dest = cpu->thread->godzilla.cc_pd;
+    cpu->cpu_iq[i].pc = cpu->thread->godzilla.pc;
+    cpu->cpu_iq[i].rob_index = cpu->thread->godzilla.rob_index;
+    cpu->cpu_iq[i].fused_opcode = cpu->thread->godzilla.fused_opcode;
+    cpu->cpu_iq[i].fused_imm = cpu->thread->godzilla.fused_imm;
+
+    if (cpu->thread->godzilla.opcode == OPCODE_HALT) {
+        cpu->cpu_iq[i].FU = INT_FU;
+    }
+    
+    if (is_indirect_jump(cpu->thread->godzilla.opcode)) {
+        /* The target register is the only source, JALR writes its return address to pd */
+        cpu->cpu_iq[i].dest = cpu->thread->godzilla.pd;
+        cpu->cpu_iq[i].FU = INT_FU;
+        bitset_set(cpu->iq_sched.ps2_ready, i);
+    }
+    else if (is_conditional_branch(cpu->thread->godzilla.opcode)) {
+        /* The flags are the only source, renamed into ps1 */
+        cpu->cpu_iq[i].FU = INT_FU;
+        bitset_set(cpu->iq_sched.ps2_ready, i);
+    }
+    else if (cpu->thread->godzilla.opcode == OPCODE_LOAD) {
+        cpu->cpu_iq[i].dest_type = dest_load_store;
+        cpu->cpu_iq[i].dest = cpu->thread->godzilla.lsq_index;
+        cpu->cpu_iq[i].FU = ADD_FU;
+        bitset_set(cpu->iq_sched.ps2_ready, i);
+        
+        // cpu->cpu_prf[cpu->thread->godzilla.ps1].lsq_dependency_list[cpu->thread->lsq_tail - 1] = 1;
+        // cpu->cpu_prf[cpu->thread->godzilla.ps2].iq_dependency_list[i] = 1;
+    }
+    else if (cpu->thread->godzilla.opcode == OPCODE_STORE) {
+        cpu->cpu_iq[i].dest_type = dest_load_store;
+        cpu->cpu_iq[i].dest = cpu->thread->godzilla.lsq_index;
+        cpu->cpu_iq[i].FU = ADD_FU;
+        bitset_set(cpu->iq_sched.ps1_ready, i);
+        
+        // cpu->cpu_prf[cpu->thread->godzilla.ps1].iq_dependency_list[i] = 1;
+    }
+    else if (cpu->thread->godzilla.opcode == OPCODE_LOADP) {
+        cpu->cpu_iq[i].dest_type = dest_loadp_storep;
+        cpu->cpu_iq[i].dest = cpu->thread->godzilla.lsq_index;
+        cpu->cpu_iq[i].FU = ADD_FU;
+        cpu->cpu_iq[i].lpsp_inc_dest = cpu->thread->godzilla.lpsp_inc_dest;
+        if (cpu->debug_messages) {
+            printf("\nlpsp_inc_dest in godzilla = %d\n", cpu->cpu_iq[i].lpsp_inc_dest);
+        }
+        bitset_set(cpu->iq_sched.ps2_ready, i);
+        
+    }
+    else if (cpu->thread->godzilla.opcode == OPCODE_STOREP) {
+        cpu->cpu_iq[i].dest_type = dest_loadp_storep;
+        cpu->cpu_iq[i].dest = cpu->thread->godzilla.lsq_index;
+        cpu->cpu_iq[i].FU = ADD_FU;
+        cpu->cpu_iq[i].lpsp_inc_dest = cpu->thread->godzilla.lpsp_inc_dest;
+        if (cpu->debug_messages) {
+            printf("\nlpsp_inc_dest in godzilla = %d\n", cpu->cpu_iq[i].lpsp_inc_dest);
+        }
+        bitset_set(cpu->iq_sched.ps1_ready, i);
+        
+    }
+    else {
+        cpu->cpu_iq[i].dest = cpu->thread->godzilla.pd;
+        if (cpu->thread->godzilla.pd == cpu->thread->godzilla.ps1) {
+            /* A move renamed onto its source at rename, only its flags are left to compute */
+            cpu->cpu_iq[i].dest = -1;
+        }
+
+        // cpu->cpu_prf[cpu->thread->godzilla.pd].iq_dependency_list[i] = 1;
+
+        switch (cpu->thread->godzilla.opcode) {
+            case OPCODE_ADD:
+            case OPCODE_SUB:
+            case OPCODE_AND:
+            case OPCODE_OR:
+            case OPCODE_XOR:
+            case OPCODE_CMP:
+            {
+                cpu->cpu_iq[i].FU = INT_FU;
+
+                break;
+            }
+
+            case OPCODE_ADDL:
+            case OPCODE_SUBL:
+            case OPCODE_CML:
+            {
+                cpu->cpu_iq[i].FU = INT_FU;
+
+                break;
+            }
+
+            case OPCODE_LOAD:
+            case OPCODE_LOADP:
+            {
+                cpu->cpu_iq[i].FU = ADD_FU;
+
+                break;
+            }
+
+            case OPCODE_STORE:
+            case OPCODE_STOREP:
+            {
+                cpu->cpu_iq[i].FU = ADD_FU;
+
+                break;
+            }
+
+            case OPCODE_MOVC:
+            {
+                cpu->cpu_iq[i].FU = INT_FU;
+
+                break;
+            }
+
+            case OPCODE_MUL:
+            {
+                cpu->cpu_iq[i].FU = MUL_FU;
+
+                break;
+            }
+
+            case OPCODE_DIV:
+            {
+                cpu->cpu_iq[i].FU = DIV_FU;
+
+                break;
+            }
+        }
+    }
+
+    bitset_clear(cpu->iq_sched.free, i);
+    bitset_set(cpu->iq_sched.valid, i);
+    if (cpu->cpu_iq[i].FU >= INT_FU && cpu->cpu_iq[i].FU < INT_FU + FU_CLASSES) {
+        bitset_set(cpu->iq_sched.fu_class[cpu->cpu_iq[i].FU - INT_FU], i);
+    }
+}
+
+/*
+This method is used to free an IQ entry once its instruction has issued
+*/
+static void iq_release_entry (APEX_CPU *cpu, int i) {
+    bitset_clear(cpu->iq_sched.valid, i);
+    bitset_set(cpu->iq_sched.free, i);
+    for (int fu = 0; fu < FU_CLASSES; fu++) {
+        bitset_clear(cpu->iq_sched.fu_class[fu], i);
+    }
+}
+
+/*
+This method marks ready every IQ and LSQ source operand waiting on one of the broadcasted tags. The
+tag arrays are compared densely by the CAM, entries that are not valid are masked out by select.
+*/
+static void wakeup_tags (APEX_CPU *cpu, const int *tags, int tag_count) {
+    CPU_IQ_Sched *sched = &cpu->iq_sched;
+    uint64_t ps1_match[IQ_WORDS];
+    uint64_t ps2_match[IQ_WORDS];
+    uint64_t lsq_match[BITSET_WORDS(LSQ_SIZE)];
+
+    tag_cam_match(sched->ps1_tag, IQ_SIZE, tags, tag_count, ps1_match);
+    tag_cam_match(sched->ps2_tag, IQ_SIZE, tags, tag_count, ps2_match);
+    for (int w = 0; w < IQ_WORDS; w++) {
+        sched->ps1_ready[w] |= ps1_match[w];
+        sched->ps2_ready[w] |= ps2_match[w];
+    }
+
+    for (int t = 0; t < cpu->thread_count; t++) {
+        APEX_Thread *thread = &cpu->threads[t];
+
+        tag_cam_match(thread->lsq_ps1_tag, LSQ_SIZE, tags, tag_count, lsq_match);
+        for (int i = bitset_next(lsq_match, BITSET_WORDS(LSQ_SIZE), 0); i != -1; i = bitset_next(lsq_match, BITSET_WORDS(LSQ_SIZE), i + 1)) {
+            if (thread->cpu_lsq[i].isValid) {
+                thread->cpu_lsq[i].ps1_valid = TRUE;
+            }
+        }
+    }
+}
+
+/*
+This method returns the oldest IQ entry of the FU class with both source operands ready, -1 if none
+*/
+static int iq_select_oldest (const APEX_CPU *cpu, int fu) {
+    const CPU_IQ_Sched *sched = &cpu->iq_sched;
+    int oldest = -1;
+
+    for (int w = 0; w < IQ_WORDS; w++) {
+        uint64_t ready = sched->valid[w] & sched->fu_class[fu - INT_FU][w] & sched->ps1_ready[w] & sched->ps2_ready[w];
+
+        while (ready) {
+            int i = w * 64 + __builtin_ctzll(ready);
+
+            if (oldest == -1 || sched->age[i] < sched->age[oldest]) {
+                oldest = i;
+            }
+            ready &= ready - 1;
+        }
+    }
+
+    return oldest;
+}
+
+/*
+This method puts a result tag on the wakeup bus. Tags broadcast during a cycle are gathered and
+handled together by the next wakeup phase. A tag that does not fit would lose its wakeup, so it stops
+the CPU.
+*/
+static void broadcast_tag (APEX_CPU *cpu, int tag) {
+    if (tag == -1) {
+        return;
+    }
+
+    if (cpu->wakeup_tag_count == WAKEUP_TAGS_MAX) {
+        fprintf(stderr, "APEX_Error: More than %d tags broadcast in cycle %d\n", WAKEUP_TAGS_MAX, cpu->clock);
+        cpu->halt_cpu = TRUE;
+        return;
+    }
+
+    cpu->wakeup_tags[cpu->wakeup_tag_count++] = tag;
+}
+
+/*
+This method implements the wakeup phase, run once per cycle: every tag broadcast since the previous
+phase (INT, MUL, DIV, post-increment and load results) wakes up the IQ and LSQ in a single CAM pass, then
+the oldest ready instruction is selected for every free FU
+*/
+void wakeup_instructions (APEX_CPU *cpu) {
+    int ready_insn;
+
+    if (cpu->wakeup_tag_count > 0) {
+        if (cpu->debug_messages) {
+            for (int i = 0; i < cpu->wakeup_tag_count; i++) {
+                printf("\nBroadcasted tag = %d\n", cpu->wakeup_tags[i]);
+            }
+        }
+
+        wakeup_tags(cpu, cpu->wakeup_tags, cpu->wakeup_tag_count);
+        cpu->wakeup_tag_count = 0;
+    }
+
+    if (cpu->execute.intFU.has_insn == FALSE) {
+        ready_insn = iq_select_oldest(cpu, INT_FU);
+        if (ready_insn != -1) {
+            cpu->intfu_ready_insn = ready_insn;
+        }
+    }
+
+    if (cpu->execute.addFU.has_insn == FALSE) {
+        ready_insn = iq_select_oldest(cpu, ADD_FU);
+        if (ready_insn != -1) {
+            cpu->addfu_ready_insn = ready_insn;
+        }
+    }
+
+    if (cpu->execute.mulFU.has_insn == FALSE) {
+        ready_insn = iq_select_oldest(cpu, MUL_FU);
+        if (ready_insn != -1) {
+            cpu->mulfu_ready_insn = ready_insn;
+        }
+    }
+
+    if (cpu->execute.divFU.has_insn == FALSE) {
+        ready_insn = iq_select_oldest(cpu, DIV_FU);
+        if (ready_insn != -1) {
+            cpu->divfu_ready_insn = ready_insn;
+        }
+    }
+}
+
+/*
+This method steps the reference model over the instructions retired from the ROB head and compares the
+architectural registers and the memory write of both. The first mismatch stops the CPU with a diff.
+*/
+static void cosim_check_retire (APEX_CPU *cpu, const CPU_ROB *entry, int is_store, int store_address, int store_value) {
+    Golden_Effects effects;
+    int mismatch = FALSE;
+
+    /* A fused pair is compared once both of its instructions have executed */
+    for (int i = 0; i <= entry->fused && !mismatch; i++) {
+        golden_model_step(&cpu->thread->golden, &effects);
+
+        if (effects.error != GOLDEN_ERROR_NONE || effects.pc != entry->pc + 4 * i) {
+            mismatch = TRUE;
+        }
+    }
+
+    for (int i = 0; i < REG_FILE_SIZE && !mismatch; i++) {
+        if (cpu->thread->regs[i] != cpu->thread->golden.regs[i]) {
+            mismatch = TRUE;
+        }
+    }
+
+    if (cpu->thread->zero_flag != cpu->thread->golden.zero_flag || cpu->thread->positive_flag != cpu->thread->golden.positive_flag ||
+        cpu->thread->negative_flag != cpu->thread->golden.negative_flag) {
+        mismatch = TRUE;
+    }
+
+    if (is_store != effects.mem_written ||
+        (is_store && (store_address != effects.mem_address || store_value != effects.mem_value))) {
+        mismatch = TRUE;
+    }
+
+    if (!mismatch) {
+        return;
+    }
+
+    cpu->cosim_failed = TRUE;
+    cpu->halt_cpu = TRUE;
+
+    fprintf(stderr, "APEX_Cosim: Mismatch at retirement %d, cycle %d\n", cpu->insn_completed, cpu->clock + 1);
+    if (cpu->thread_count > 1) {
+        fprintf(stderr, "  thread %d, retirement %d of the thread\n", cpu->thread->id, cpu->thread->insn_completed);
+    }
+    fprintf(stderr, "  pipeline retired pc(%d), reference executed pc(%d) %s\n", entry->pc, effects.pc,
+            effects.opcode != -1 ? cpu->thread->golden.code_memory[(effects.pc - 4000) / 4].opcode_str : "<none>");
+
+    if (effects.error != GOLDEN_ERROR_NONE) {
+        fprintf(stderr, "  reference model error %d\n", effects.error);
+    }
+
+    for (int i = 0; i < REG_FILE_SIZE; i++) {
+        if (cpu->thread->regs[i] != cpu->thread->golden.regs[i]) {
+            fprintf(stderr, "  R%d: pipeline %d, reference %d\n", i, cpu->thread->regs[i], cpu->thread->golden.regs[i]);
+        }
+    }
+
+    if (cpu->thread->zero_flag != cpu->thread->golden.zero_flag || cpu->thread->positive_flag != cpu->thread->golden.positive_flag ||
+        cpu->thread->negative_flag != cpu->thread->golden.negative_flag) {
+        fprintf(stderr, "  flags Z/P/N: pipeline %d/%d/%d, reference %d/%d/%d\n",
+                cpu->thread->zero_flag, cpu->thread->positive_flag, cpu->thread->negative_flag,
+                cpu->thread->golden.zero_flag, cpu->thread->golden.positive_flag, cpu->thread->golden.negative_flag);
+    }
+
+    if (is_store || effects.mem_written) {
+        fprintf(stderr, "  store: pipeline %s MEM[%d] = %d, reference %s MEM[%d] = %d\n",
+                is_store ? "" : "(none)", store_address, store_value,
+                effects.mem_written ? "" : "(none)", effects.mem_address, effects.mem_value);
+    }
+}
+
+/*
+This method retires the instruction at the ROB head: its destination registers and flags are written to
+the architectural state, the physical registers it overwrote are released and the ROB head moves on.
+*/
+static void retire_rob_head (APEX_CPU *cpu, int is_store, int store_address, int store_value) {
+    CPU_ROB *entry = &cpu->thread->cpu_rob[cpu->thread->rob_head];
+
+    /* The MOVC of a fused pair is the older instruction, rd of the pair may overwrite its register */
+    if (entry->fused_rd != -1) {
+        cpu->thread->regs[entry->fused_rd] = cpu->cpu_prf[entry->fused_pd].value;
+        cpu->cpu_prf[entry->fused_pd].pending_retires--;
+    }
+
+    if (entry->rd != -1) {
+        cpu->thread->regs[entry->rd] = cpu->cpu_prf[entry->pd].value;
+        cpu->cpu_prf[entry->pd].pending_retires--;
+    }
+
+    if (entry->lpsp_rd != -1) {
+        cpu->thread->regs[entry->lpsp_rd] = cpu->cpu_prf[entry->lpsp_pd].value;
+        cpu->cpu_prf[entry->lpsp_pd].pending_retires--;
+    }
+
+    if (entry->overwritten_pd != -1) {
+        release_phys_reg(cpu, entry->overwritten_pd);
+    }
+
+    if (entry->lpsp_overwritten_pd != -1) {
+        release_phys_reg(cpu, entry->lpsp_overwritten_pd);
+    }
+
+    if (entry->fused_overwritten_pd != -1) {
+        release_phys_reg(cpu, entry->fused_overwritten_pd);
+    }
+
+    if (entry->cc_pd != -1) {
+        int flags = cpu->cpu_cprf[entry->cc_pd].value;
+
+        cpu->thread->zero_flag = (flags & FLAG_ZERO) != 0;
+        cpu->thread->positive_flag = (flags & FLAG_POSITIVE) != 0;
+        cpu->thread->negative_flag = (flags & FLAG_NEGATIVE) != 0;
+    }
+
+    if (entry->cc_overwritten_pd != -1) {
+        release_cc_reg(cpu, entry->cc_overwritten_pd);
+    }
+
+    cpu->insn_completed += 1 + entry->fused;
+    cpu->thread->insn_completed += 1 + entry->fused;
+    cpu->thread->last_retired_pc = entry->pc + 4 * entry->fused;
+    cpu->stats.fused_pairs += entry->fused;
+
+    if (cpu->pipeview) {
+        pipeview_retire(cpu->pipeview, entry->seq, cpu->clock + 1, is_store);
+        if (entry->fused) {
+            pipeview_fuse(cpu->pipeview, entry->seq, entry->fused_seq);
+            pipeview_retire(cpu->pipeview, entry->fused_seq, cpu->clock + 1, is_store);
+        }
+    }
+
+    if (cpu->cosim_enabled) {
+        cosim_check_retire(cpu, entry, is_store, store_address, store_value);
+    }
+
+    entry->isValid = FALSE;
+    cpu->thread->rob_head = (cpu->thread->rob_head + 1) % ROB_SIZE;
+}
+
+#if PRF_EARLY_RELEASE
+/*
+This method returns TRUE if an instruction waiting in the IQ or LSQ may still read the physical register.
+Tags of sources an instruction does not use are matched too, which only delays the release.
+*/
+static int phys_reg_has_readers (const APEX_CPU *cpu, int reg) {
+    for (int i = bitset_next(cpu->iq_sched.valid, IQ_WORDS, 0); i != -1; i = bitset_next(cpu->iq_sched.valid, IQ_WORDS, i + 1)) {
+        if (cpu->iq_sched.ps1_tag[i] == reg || cpu->iq_sched.ps2_tag[i] == reg) {
+            return TRUE;
+        }
+    }
+
+    for (int i = 0; i < LSQ_SIZE; i++) {
+        if (cpu->thread->cpu_lsq[i].isValid && cpu->thread->lsq_ps1_tag[i] == reg) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/*
+This method frees the register an instruction overwrote without waiting for the instruction to retire
+*/
+static void release_if_dead (APEX_CPU *cpu, int *overwritten_pd) {
+    if (*overwritten_pd != -1 && cpu->cpu_prf[*overwritten_pd].pending_retires == 0 &&
+        !phys_reg_has_readers(cpu, *overwritten_pd)) {
+        release_phys_reg(cpu, *overwritten_pd);
+        *overwritten_pd = -1;
+        cpu->stats.regs_released_early++;
+    }
+}
+
+/*
+This method releases early the physical registers overwritten by the instructions older than every
+unresolved branch. Such a register is dead once its own value has retired and every older reader in
+the IQ and LSQ has read it: no mispredict can map it again, and the architectural register file
+already holds its value should an older instruction fault.
+*/
+static void release_dead_regs (APEX_CPU *cpu) {
+    int oldest_branch_seq = INT32_MAX;
+
+    for (int i = 0; i < CHECKPOINT_COUNT; i++) {
+        if (cpu->thread->checkpoints[i].isValid && cpu->thread->checkpoints[i].seq < oldest_branch_seq) {
+            oldest_branch_seq = cpu->thread->checkpoints[i].seq;
+        }
+    }
+
+    for (int i = cpu->thread->rob_head, n = 0; n < ROB_SIZE && cpu->thread->cpu_rob[i].isValid; i = (i + 1) % ROB_SIZE, n++) {
+        if (cpu->thread->cpu_rob[i].seq > oldest_branch_seq) {
+            break;
+        }
+
+        release_if_dead(cpu, &cpu->thread->cpu_rob[i].overwritten_pd);
+        release_if_dead(cpu, &cpu->thread->cpu_rob[i].lpsp_overwritten_pd);
+        release_if_dead(cpu, &cpu->thread->cpu_rob[i].fused_overwritten_pd);
+    }
+}
+#endif
+
+/*
+This method squashes every instruction younger than the mispredicted branch or value-predicted load at
+rob_index and restarts fetch at next_pc. The rename state comes back in one step from the checkpoint of
+that instruction; the ROB, LSQ and IQ drop their younger entries and the front end and the FUs are
+emptied of them.
+*/
+static void flush_younger (APEX_CPU *cpu, int rob_index, int next_pc) {
+    const CPU_ROB *entry = &cpu->thread->cpu_rob[rob_index];
+    const Rename_Checkpoint *checkpoint = &cpu->thread->checkpoints[entry->checkpoint];
+    int first_lsq_index = -1;
+    int squashed = 0;
+    int i;
+
+    /* Registers allocated after the checkpoint go back to the free lists, references taken by the
+       squashed moves are dropped */
+    memcpy(cpu->thread->rename_table, checkpoint->rename_table, sizeof(cpu->thread->rename_table));
+    for (i = 0; i < cpu->prf_size; i++) {
+        if (bitset_test(checkpoint->allocated, i)) {
+            cpu->cpu_prf[i].refs = 0;
+            bitset_set(cpu->free_regs, i);
+        }
+        else if (checkpoint->shared[i] > 0) {
+            cpu->cpu_prf[i].refs -= checkpoint->shared[i];
+            cpu->cpu_prf[i].pending_retires -= checkpoint->shared[i];
+            if (cpu->cpu_prf[i].refs == 0) {
+                bitset_set(cpu->free_regs, i);
+            }
+        }
+    }
+    cpu->free_reg_count = bitset_count(cpu->free_regs, PRF_WORDS);
+    cpu->thread->cc_rename = checkpoint->cc_rename;
+    cpu->thread->cc_free_count += cpu->thread->cc_free_allocs - checkpoint->cc_free_allocs;
+    cpu->thread->cc_free_head = checkpoint->cc_free_head;
+    cpu->thread->cc_free_allocs = checkpoint->cc_free_allocs;
+    target_predictor_ras_restore(&cpu->thread->target_pred, checkpoint->ras_state);
+
+    /* Checkpoints of squashed instructions go, the older ones forget the registers and references just
+       dropped so that a flush back to one of them does not drop them again, once another thread may
+       have taken the registers */
+    for (i = 0; i < CHECKPOINT_COUNT; i++) {
+        if (cpu->thread->checkpoints[i].isValid && cpu->thread->checkpoints[i].seq > entry->seq) {
+            cpu->thread->checkpoints[i].isValid = FALSE;
+        }
+        else if (cpu->thread->checkpoints[i].isValid && cpu->thread->checkpoints[i].seq < entry->seq) {
+            for (int w = 0; w < PRF_WORDS; w++) {
+                cpu->thread->checkpoints[i].allocated[w] &= ~checkpoint->allocated[w];
+            }
+            for (int reg = 0; reg < cpu->prf_size; reg++) {
+                cpu->thread->checkpoints[i].shared[reg] -= checkpoint->shared[reg];
+            }
+        }
+    }
+
+    /* The ROB holds the younger instructions from the flushing one to the tail, the LSQ its memory ones */
+    for (i = (rob_index + 1) % ROB_SIZE; i != cpu->thread->rob_head && cpu->thread->cpu_rob[i].isValid; i = (i + 1) % ROB_SIZE) {
+        if (cpu->thread->cpu_rob[i].lsq_index != -1) {
+            if (first_lsq_index == -1) {
+                first_lsq_index = cpu->thread->cpu_rob[i].lsq_index;
+            }
+            cpu->thread->cpu_lsq[cpu->thread->cpu_rob[i].lsq_index].isValid = FALSE;
+            cpu->thread->lsq_ps1_tag[cpu->thread->cpu_rob[i].lsq_index] = -1;
+        }
+        cpu->thread->cpu_rob[i].isValid = FALSE;
+        squashed += 1 + cpu->thread->cpu_rob[i].fused;
+    }
+    cpu->thread->rob_tail = (rob_index + 1) % ROB_SIZE;
+    if (first_lsq_index != -1) {
+        cpu->thread->lsq_tail = first_lsq_index;
+    }
+
+#if LOAD_VALUE_PREDICTION
+    /* Squashed loads never train the value predictor, the loads left are counted in flight again */
+    value_predictor_clear_in_flight(&cpu->thread->value_pred);
+    for (i = cpu->thread->rob_head; ; i = (i + 1) % ROB_SIZE) {
+        if (cpu->thread->cpu_rob[i].lsq_index != -1 && cpu->thread->cpu_lsq[cpu->thread->cpu_rob[i].lsq_index].lORs == 1) {
+            value_predictor_add_in_flight(&cpu->thread->value_pred, cpu->thread->cpu_rob[i].pc);
+        }
+        if (i == rob_index) {
+            break;
+        }
+    }
+#endif
+
+    /* The IQ and the FUs hold the instructions of the other threads too */
+    for (i = 0; i < IQ_SIZE; i++) {
+        if (bitset_test(cpu->iq_sched.valid, i) && cpu->cpu_iq[i].thread == cpu->thread->id &&
+            cpu->cpu_iq[i].seq > entry->seq) {
+            iq_release_entry(cpu, i);
+        }
+    }
+    cpu->intfu_ready_insn = -1;
+    cpu->addfu_ready_insn = -1;
+    cpu->mulfu_ready_insn = -1;
+    cpu->divfu_ready_insn = -1;
+
+    /* A load flushes after issue, which may have sent younger instructions to the INT FU. The MUL and DIV
+       FUs ran earlier this cycle, a result they put on the bus is dropped */
+    if (cpu->execute.intFU.has_insn && cpu->execute.intFU.thread == cpu->thread->id && cpu->execute.intFU.seq > entry->seq) {
+        cpu->execute.intFU.has_insn = FALSE;
+        cpu->execute.intFU.forwarded_from_mul = 0;
+    }
+    if (cpu->execute.mulFU.thread == cpu->thread->id && cpu->execute.mulFU.seq > entry->seq) {
+        if (cpu->execute.mulFU.has_insn) {
+            cpu->execute.mulFU.has_insn = FALSE;
+            cpu->execute.mulFU.forwarded_from_mul = 0;
+            cpu->execute.mulFU_clock = 0;
+            timing_wheel_cancel(&cpu->timing_wheel, EVENT_MUL_DONE);
+        }
+        cpu->mulFU_broadcasted_tag = -1;
+    }
+    if (cpu->execute.divFU.has_insn && cpu->execute.divFU.thread == cpu->thread->id && cpu->execute.divFU.seq > entry->seq) {
+        cpu->execute.divFU.has_insn = FALSE;
+        cpu->execute.divFU_clock = 0;
+        timing_wheel_cancel(&cpu->timing_wheel, EVENT_DIV_DONE);
+    }
+    if (cpu->execute.addFU.has_insn && cpu->execute.addFU.thread == cpu->thread->id && cpu->execute.addFU.seq > entry->seq) {
+        cpu->execute.addFU.has_insn = FALSE;
+        cpu->execute.addFU.forwarded_from_mul = 0;
+    }
+
+    /* Younger instructions still in the front end were never given ROB entries */
+    squashed += cpu->thread->decode_rename.has_insn + cpu->thread->fetch_buffer.has_insn;
+    if (cpu->thread->rename_dispatch.has_insn) {
+        squashed += 1 + (cpu->thread->rename_dispatch.fused_opcode != -1);
+    }
+    if (cpu->thread->godzilla.insn_pending) {
+        squashed += 1 + (cpu->thread->godzilla.fused_opcode != -1);
+    }
+    cpu->thread->fetch_buffer.has_insn = FALSE;
+    cpu->thread->decode_rename.has_insn = FALSE;
+    cpu->thread->rename_dispatch.has_insn = FALSE;
+    cpu->thread->godzilla.insn_pending = FALSE;
+    /* A HALT fetched down the wrong path no longer holds dispatch */
+    cpu->thread->godzilla.opcode = OPCODE_NOP;
+    cpu->thread->fetch.has_insn = TRUE;
+    cpu->thread->branch_in_flight = FALSE;
+    cpu->thread->pc = next_pc;
+
+    cpu->stats.insns_squashed += squashed;
+}
+
+#if LOAD_VALUE_PREDICTION
+/*
+This method checks the value the load at the ROB head returned against the one predicted for it, if
+any, and trains the value predictor with it. The instructions younger than a load predicted wrong ran
+with the wrong value: they are flushed and fetched again. The checkpoint of the load is freed.
+*/
+static void verify_value_prediction (APEX_CPU *cpu, int load_value) {
+    const CPU_ROB *entry = &cpu->thread->cpu_rob[cpu->thread->rob_head];
+
+    if (entry->checkpoint != -1) {
+        cpu->stats.value_predictions++;
+        if (cpu->cpu_prf[entry->pd].value != load_value) {
+            flush_younger(cpu, cpu->thread->rob_head, entry->pc + 4);
+            cpu->stats.value_mispredicts++;
+        }
+        cpu->thread->checkpoints[entry->checkpoint].isValid = FALSE;
+    }
+
+    /* After the flush, which counts the loads left in flight again, this one among them */
+    value_predictor_train(&cpu->thread->value_pred, entry->pc, load_value);
+}
+#endif
+
+/*
+This method is used to record a data memory fault against the instruction at the ROB head and stop the CPU
+*/
+void raise_memory_error (APEX_CPU *cpu, int address) {
+    cpu->thread->cpu_rob[cpu->thread->rob_head].mem_error_codes = MEM_ERROR_OUT_OF_BOUNDS;
+    cpu->mem_stage_clock = 0;
+    cpu->halt_cpu = TRUE;
+
+    fprintf(stderr, "APEX_Error: Data memory access out of bounds at pc(%d), address %d\n",
+            cpu->thread->cpu_rob[cpu->thread->rob_head].pc, address);
+}
+
+/*
+This method advances the memory access of the LSQ head by one cycle. The access looks up the data
+cache when it starts, and its response is scheduled on the timing wheel after the latency of the
+hit or miss; returns TRUE once it has arrived. The threads share the memory port, an access does not
+start while the one of another thread is in flight.
+*/
+static int memory_access_done (APEX_CPU *cpu) {
+    if (cpu->mem_stage_clock > 0 && cpu->mem_port_thread != cpu->thread) {
+        return FALSE;
+    }
+
+    if (cpu->mem_stage_clock == 0) {
+        int latency;
+
+        cpu->mem_port_thread = cpu->thread;
+
+        switch (data_cache_access(&cpu->dcache, cpu->thread->cpu_lsq[cpu->thread->lsq_head].memory, cpu->clock, &latency)) {
+            case DCACHE_MISS:
+                cpu->stats.dcache_misses++;
+                break;
+
+            case DCACHE_PREFETCH_HIT:
+                cpu->stats.prefetches_useful++;
+                cpu->stats.prefetches_late += latency > MEM_ACCESS_LATENCY;
+                break;
+        }
+        cpu->stats.dcache_accesses++;
+
+        if (!timing_wheel_schedule(&cpu->timing_wheel, cpu->clock, latency - 1, EVENT_MEM_DONE)) {
+            cpu->halt_cpu = TRUE;
+            return FALSE;
+        }
+    }
+
+    cpu->mem_stage_clock++;
+
+    return timing_wheel_take(&cpu->timing_wheel, EVENT_MEM_DONE);
+}
+
+/*
+This method is used to perform load/store operation by popping out the entry at the head of the LSQ 
+and performing the memory access operations
+*/
+void perform_load_store (APEX_CPU *cpu) {
+    if (cpu->thread->cpu_lsq[cpu->thread->lsq_head].mem_valid) {
+        if (cpu->thread->cpu_lsq[cpu->thread->lsq_head].lORs == 0) {
+            if (cpu->cpu_prf[cpu->thread->cpu_lsq[cpu->thread->lsq_head].ps1_tag].isValid || 
+                cpu->thread->cpu_lsq[cpu->thread->lsq_head].ps1_tag == cpu->intFU_broadcasted_tag || 
+                cpu->thread->cpu_lsq[cpu->thread->lsq_head].ps1_tag == cpu->mulFU_broadcasted_tag) {
+                if (memory_access_done(cpu)) {
+                    int store_value = 0;
+
+                    if (cpu->cpu_prf[cpu->thread->cpu_lsq[cpu->thread->lsq_head].ps1_tag].isValid) {
+                        store_value = cpu->cpu_prf[cpu->thread->cpu_lsq[cpu->thread->lsq_head].ps1_tag].value;
+                    }
+                    else {
+                        if (cpu->thread->cpu_lsq[cpu->thread->lsq_head].ps1_tag == cpu->intFU_broadcasted_tag) {
+                            store_value = cpu->intFU_broadcasted_value;
+                        }
+                        else if (cpu->thread->cpu_lsq[cpu->thread->lsq_head].ps1_tag == cpu->mulFU_broadcasted_tag) {
+                            store_value = cpu->mulFU_broadcasted_value;
+                        }
+                    }
+
+                    if (!data_memory_write(&cpu->data_memory, cpu->thread->cpu_lsq[cpu->thread->lsq_head].memory, store_value)) {
+                        raise_memory_error(cpu, cpu->thread->cpu_lsq[cpu->thread->lsq_head].memory);
+                        return;
+                    }
+
+                    if (cpu->store_log && !store_log_append(cpu->store_log, cpu->thread->cpu_lsq[cpu->thread->lsq_head].memory, store_value)) {
+                        fprintf(stderr, "APEX_Error: Unable to log the store at pc(%d) for the other cores\n",
+                                cpu->thread->cpu_rob[cpu->thread->rob_head].pc);
+                        cpu->halt_cpu = TRUE;
+                        return;
+                    }
+
+                    /* The reference models of the other threads load what the store left in memory */
+                    for (int t = 0; cpu->cosim_enabled && t < cpu->thread_count; t++) {
+                        if (&cpu->threads[t] != cpu->thread) {
+                            data_memory_write(&cpu->threads[t].golden.data_memory, cpu->thread->cpu_lsq[cpu->thread->lsq_head].memory, store_value);
+                        }
+                    }
+
+                    cpu->mem_stage_clock = 0;
+
+                    cpu->thread->cpu_lsq[cpu->thread->lsq_head].isValid = FALSE;
+                    retire_rob_head(cpu, TRUE, cpu->thread->cpu_lsq[cpu->thread->lsq_head].memory, store_value);
+                    cpu->thread->lsq_head = (cpu->thread->lsq_head + 1) % LSQ_SIZE;
+                }
+            }
+        }
+        else if (cpu->thread->cpu_lsq[cpu->thread->lsq_head].lORs == 1) {
+            if (memory_access_done(cpu)) {
+                int load_value;
+
+                if (!data_memory_read(&cpu->data_memory, cpu->thread->cpu_lsq[cpu->thread->lsq_head].memory, &load_value)) {
+                    raise_memory_error(cpu, cpu->thread->cpu_lsq[cpu->thread->lsq_head].memory);
+                    return;
+                }
+
+                int load_pd = cpu->thread->cpu_lsq[cpu->thread->lsq_head].pd;
+
+#if LOAD_VALUE_PREDICTION
+                verify_value_prediction(cpu, load_value);
+#endif
+                cpu->cpu_prf[load_pd].isValid = TRUE;
+                cpu->cpu_prf[load_pd].value = load_value;
+
+                cpu->mem_stage_clock = 0;
+
+                trace_stage(cpu, cpu->thread->cpu_rob[cpu->thread->rob_head].seq, PIPEVIEW_COMPLETE);
+                cpu->thread->cpu_lsq[cpu->thread->lsq_head].isValid = FALSE;
+                retire_rob_head(cpu, FALSE, 0, 0);
+                cpu->thread->lsq_head = (cpu->thread->lsq_head + 1) % LSQ_SIZE;
+
+                if (cpu->debug_messages) {
+                    printf("\nmem[%d] => p[%d] = %d\n", cpu->thread->cpu_lsq[(cpu->thread->lsq_head + LSQ_SIZE - 1) % LSQ_SIZE].memory, load_pd, load_value);
+                }
+                broadcast_tag(cpu, load_pd);
+            }
+        }
+    }
+}
+
+/*
+This method enters the instruction dispatched by the thread into the LSQ, ROB and IQ
+*/
+static void godzilla_allocate (APEX_CPU *cpu) {
+    if (cpu->thread->godzilla.insn_pending == TRUE) {
+        cpu->thread->godzilla.insn_pending = FALSE;
+        trace_stage(cpu, cpu->thread->godzilla.seq, PIPEVIEW_DISPATCH);
+
+        if (cpu->thread->godzilla.opcode == OPCODE_HALT) {
+            cpu->thread->godzilla.enter_godzilla = FALSE;
+            cpu->thread->godzilla.stall_cause = STALL_HALT;
+        }
+
+        if (cpu->thread->godzilla.opcode == OPCODE_LOAD || 
+            cpu->thread->godzilla.opcode == OPCODE_STORE || 
+            cpu->thread->godzilla.opcode == OPCODE_LOADP || 
+            cpu->thread->godzilla.opcode == OPCODE_STOREP) {
+            setup_entry_in_lsq(cpu);
+        }
+        else {
+            cpu->thread->godzilla.lsq_index = -1;
+        }
+
+        setup_entry_in_rob(cpu);
+
+#if LOAD_VALUE_PREDICTION
+        /* Dependents of a value-predicted load go ahead with the predicted value, the load checks it
+           when the data comes back from memory */
+        if (cpu->thread->godzilla.lsq_index != -1 && cpu->thread->godzilla.checkpoint != -1) {
+            cpu->cpu_prf[cpu->thread->godzilla.pd].value = cpu->thread->godzilla.pred_value;
+            cpu->cpu_prf[cpu->thread->godzilla.pd].isValid = TRUE;
+            broadcast_tag(cpu, cpu->thread->godzilla.pd);
+        }
+#endif
+
+        /* HALT, NOP and the instructions completed at rename only need a ROB entry, they retire when they
+           reach the ROB head */
+        if (cpu->thread->godzilla.opcode != OPCODE_HALT && cpu->thread->godzilla.opcode != OPCODE_NOP && !cpu->thread->godzilla.eliminated) {
+            setup_entry_in_iq(cpu);
+        }
+    }
+}
+
+/*
+This method commits the instruction at the ROB head of the thread, performing its memory access first if
+it is a load or store
+*/
+static void godzilla_commit (APEX_CPU *cpu) {
+    if (!cpu->thread->cpu_rob[cpu->thread->rob_head].isValid) {
+        /* The ROB is empty, the head entry is left over from an instruction already retired or squashed */
+    }
+    else if (cpu->thread->cpu_rob[cpu->thread->rob_head].insn_type == dest_load_store || cpu->thread->cpu_rob[cpu->thread->rob_head].insn_type == dest_loadp_storep) {
+        HOST_PROFILE_LAP(cpu, PROF_GODZILLA_COMMIT);
+        perform_load_store(cpu);
+        HOST_PROFILE_LAP(cpu, PROF_GODZILLA_LSQ);
+    }
+    else if (cpu->thread->cpu_rob[cpu->thread->rob_head].insn_type == dest_halt) {
+        retire_rob_head(cpu, FALSE, 0, 0);
+        cpu->thread->godzilla.has_insn = FALSE;
+        cpu->thread->halt_cycle = cpu->clock + 1;
+
+        /* The CPU stops once the last of its threads has halted */
+        cpu->execute.is_halt_insn = TRUE;
+        for (int t = 0; t < cpu->thread_count; t++) {
+            if (cpu->threads[t].halt_cycle == -1) {
+                cpu->execute.is_halt_insn = FALSE;
+            }
+        }
+    }
+    else if (cpu->thread->cpu_rob[cpu->thread->rob_head].insn_type == dest_none) {
+        retire_rob_head(cpu, FALSE, 0, 0);
+    }
+    else {
+        // printf("\nChecking if rob head is ready to commit: %d == %d\n", cpu->thread->cpu_rob[cpu->thread->rob_head].pd, cpu->cpu_prf[cpu->thread->cpu_rob[cpu->thread->rob_head].pd].isValid);
+        if (rob_entry_done(cpu, &cpu->thread->cpu_rob[cpu->thread->rob_head])) {
+            if (cpu->thread->cpu_rob[cpu->thread->rob_head].mem_error_codes == MEM_ERROR_DIV_BY_ZERO) {
+                raise_divide_error(cpu);
+            }
+            else {
+                retire_rob_head(cpu, FALSE, 0, 0);
+            }
+
+            // printf("\nReg updated is: %d: %d\n", cpu->thread->cpu_rob[cpu->thread->rob_head-1].rd, cpu->thread->regs[cpu->thread->cpu_rob[cpu->thread->rob_head-1].rd]);
+        }
+        // else if (cpu->thread->cpu_rob[cpu->thread->rob_head].pd == cpu->intFU_broadcasted_tag) {
+        //     cpu->thread->regs[cpu->thread->cpu_rob[cpu->thread->rob_head].rd] = cpu->intFU_broadcasted_value;
+
+        //     if (cpu->thread->cpu_rob[cpu->thread->rob_head].overwritten_pd != -1) {
+        //         cpu->free_reg_list[cpu->free_reg_tail] = cpu->thread->cpu_rob[cpu->thread->rob_head].overwritten_pd;
+        //         cpu->free_reg_tail = (cpu->free_reg_tail + 1) % PRF_SIZE;
+        //     }
+
+        //     cpu->thread->cpu_rob[cpu->thread->rob_head].isValid = FALSE;
+        //     cpu->thread->rob_head = (cpu->thread->rob_head + 1) % ROB_SIZE;
+        // }
+        // else if (cpu->thread->cpu_rob[cpu->thread->rob_head].pd == cpu->mulFU_broadcasted_tag) {
+        //     cpu->thread->regs[cpu->thread->cpu_rob[cpu->thread->rob_head].rd] = cpu->mulFU_broadcasted_value;
+
+        //     if (cpu->thread->cpu_rob[cpu->thread->rob_head].overwritten_pd != -1) {
+        //         cpu->free_reg_list[cpu->free_reg_tail] = cpu->thread->cpu_rob[cpu->thread->rob_head].overwritten_pd;
+        //         cpu->free_reg_tail = (cpu->free_reg_tail + 1) % PRF_SIZE;
+        //     }
+
+        //     cpu->thread->cpu_rob[cpu->thread->rob_head].isValid = FALSE;
+        //     cpu->thread->rob_head = (cpu->thread->rob_head + 1) % ROB_SIZE;
+        // }
+    }
+}
+
+/*
+This method implements:
+- setting up entries in IQ,
+- setting up entries in ROB,
+- setting up entries in LSQ,
+- setting up entries in BQ,
+- setting up entries in BIS,
+- waking up instructions for issue,
+- committing instructions from ROB,
+- making load/store accesses from LSQ
+- notifying if dispatch should stall
+*/
+static void
+APEX_Godzilla(APEX_CPU *cpu) {
+    int running = FALSE;
+
+    /* The threads allocate, commit and decide on their dispatch stalls one after the other, around the
+       wakeup, issue and writeback of the back end they share */
+    for (int t = 0; t < cpu->thread_count; t++) {
+        cpu->thread = &cpu->threads[t];
+        if (cpu->thread->godzilla.has_insn) {
+            godzilla_allocate(cpu);
+            running = TRUE;
+        }
+    }
+
+    if (running) {
+        HOST_PROFILE_LAP(cpu, PROF_GODZILLA_ALLOCATE);
+
+        // // printf("\nInstruction woken is: iq[%d]\n", cpu->intfu_ready_insn);
+        // printf("\nINTFU: Instruction ready to go: %d\n", cpu->intfu_ready_insn);
+        // printf("\nMULFU: Instruction ready to go: %d\n", cpu->mulfu_ready_insn);
+
+        wakeup_instructions(cpu);
+        HOST_PROFILE_LAP(cpu, PROF_GODZILLA_WAKEUP);
+
+        if (cpu->intfu_ready_insn != -1) {
+            cpu->execute.intFU.has_insn = TRUE;
+            cpu->execute.intFU.seq = cpu->cpu_iq[cpu->intfu_ready_insn].seq;
+            cpu->execute.intFU.thread = cpu->cpu_iq[cpu->intfu_ready_insn].thread;
+            trace_stage(cpu, cpu->execute.intFU.seq, PIPEVIEW_ISSUE);
+
+            cpu->execute.intFU.pd = cpu->cpu_iq[cpu->intfu_ready_insn].dest;
+            cpu->execute.intFU.cc_tag = cpu->cpu_iq[cpu->intfu_ready_insn].cc_dest;
+            cpu->execute.intFU.pc = cpu->cpu_iq[cpu->intfu_ready_insn].pc;
+            cpu->execute.intFU.rob_index = cpu->cpu_iq[cpu->intfu_ready_insn].rob_index;
+            cpu->execute.intFU.fused_opcode = cpu->cpu_iq[cpu->intfu_ready_insn].fused_opcode;
+            cpu->execute.intFU.fused_imm = cpu->cpu_iq[cpu->intfu_ready_insn].fused_imm;
+            
+            if (is_conditional_branch(cpu->cpu_iq[cpu->intfu_ready_insn].function_type)) {
+                /* Flags written this cycle are already in the condition code register */
+                cpu->execute.intFU.cc_value = cpu->cpu_cprf[cpu->iq_sched.ps1_tag[cpu->intfu_ready_insn] - CC_TAG(0)].value;
+            }
+            else {
+                if (cpu->intFU_broadcasted_tag == cpu->iq_sched.ps1_tag[cpu->intfu_ready_insn]) {
+                    cpu->execute.intFU.ps1_value = cpu->intFU_broadcasted_value;
+                    cpu->execute.intFU.ps1 = cpu->iq_sched.ps1_tag[cpu->intfu_ready_insn];
+
+                }
+                else if (cpu->mulFU_broadcasted_tag == cpu->iq_sched.ps1_tag[cpu->intfu_ready_insn]) {
+                    cpu->execute.intFU.ps1_value = cpu->mulFU_broadcasted_value;
+                    cpu->execute.intFU.ps1 = cpu->iq_sched.ps1_tag[cpu->intfu_ready_insn];
+                    cpu->execute.intFU.forwarded_from_mul = 1;
+
+                    // printf("\nMUL forwarded to INT: pd[%d], ps1[%d]:%d, ps2[%d]:%d\n", cpu->execute.intFU.pd, cpu->execute.intFU.ps1, cpu->execute.intFU.ps1_value, cpu->execute.intFU.ps2, cpu->execute.intFU.ps2_value);
+
+                }
+                else {
+                    cpu->execute.intFU.ps1_value = cpu->cpu_prf[cpu->iq_sched.ps1_tag[cpu->intfu_ready_insn]].value;
+
+                }
+
+                if (cpu->intFU_broadcasted_tag == cpu->iq_sched.ps2_tag[cpu->intfu_ready_insn]) {
+                    cpu->execute.intFU.ps2_value = cpu->intFU_broadcasted_value;
+                    cpu->execute.intFU.ps2 = cpu->iq_sched.ps2_tag[cpu->intfu_ready_insn];
+
+                }
+                else if (cpu->mulFU_broadcasted_tag == cpu->iq_sched.ps2_tag[cpu->intfu_ready_insn]) {
+                    cpu->execute.intFU.ps2_value = cpu->mulFU_broadcasted_value;
+                    cpu->execute.intFU.ps2 = cpu->iq_sched.ps2_tag[cpu->intfu_ready_insn];
+                    cpu->execute.intFU.forwarded_from_mul = 2;
+
+                }
+                else {
+                    cpu->execute.intFU.ps2_value = cpu->cpu_prf[cpu->iq_sched.ps2_tag[cpu->intfu_ready_insn]].value;
+                    cpu->execute.intFU.ps2 = cpu->iq_sched.ps2_tag[cpu->intfu_ready_insn];
+
+                }
+            }
+
+            // if (cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag &&
+            //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag &&
+            //     cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->intfu_ready_insn].ps2_tag &&
+            //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->intfu_ready_insn].ps2_tag) {
+            //     cpu->execute.intFU.ps1 = cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag;
+            //     cpu->execute.intFU.ps2 = cpu->cpu_iq[cpu->intfu_ready_insn].ps2_tag;
+            //     cpu->execute.intFU.ps1_value = cpu->cpu_prf[cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag].value;
+            //     cpu->execute.intFU.ps2_value = cpu->cpu_prf[cpu->cpu_iq[cpu->intfu_ready_insn].ps2_tag].value;
+
+            //     cpu->cpu_prf[cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag] = 0;
+            //     cpu->cpu_prf[cpu->cpu_iq[cpu->intfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->intfu_ready_insn].ps2_tag] = 0;
+            // }
+
+            cpu->execute.intFU.imm = cpu->cpu_iq[cpu->intfu_ready_insn].literal;
+            cpu->execute.intFU.opcode = cpu->cpu_iq[cpu->intfu_ready_insn].function_type;
+
+            // printf("\npd[%d] = ps1[%d], ps2[%d], imm[%d]\n", cpu->execute.intFU.pd, cpu->execute.intFU.ps1, cpu->execute.intFU.ps2, cpu->execute.intFU.imm);
+
+            iq_release_entry(cpu, cpu->intfu_ready_insn);
+            cpu->intfu_ready_insn = -1;
+            // // printf("\nexecute: pd: %d, ps1: %d, ps2: %d\n", cpu->execute.intFU.pd, cpu->execute.intFU.ps1, cpu->execute.intFU.ps2);
+        }
+
+        if (cpu->addfu_ready_insn != -1) {
+            cpu->execute.addFU.has_insn = TRUE;
+            cpu->execute.addFU.seq = cpu->cpu_iq[cpu->addfu_ready_insn].seq;
+            cpu->execute.addFU.thread = cpu->cpu_iq[cpu->addfu_ready_insn].thread;
+            trace_stage(cpu, cpu->execute.addFU.seq, PIPEVIEW_ISSUE);
+
+            cpu->execute.addFU.pd = cpu->cpu_iq[cpu->addfu_ready_insn].dest;
+            cpu->execute.addFU.pc = cpu->cpu_iq[cpu->addfu_ready_insn].pc;
+            cpu->execute.addFU.lpsp_inc_dest = cpu->cpu_iq[cpu->addfu_ready_insn].lpsp_inc_dest;
+            
+            if (cpu->cpu_iq[cpu->addfu_ready_insn].function_type == OPCODE_LOAD || cpu->cpu_iq[cpu->addfu_ready_insn].function_type == OPCODE_LOADP) {
+                if (cpu->intFU_broadcasted_tag == cpu->iq_sched.ps1_tag[cpu->addfu_ready_insn]) {
+                    cpu->execute.addFU.ps1_value = cpu->intFU_broadcasted_value;
+                    cpu->execute.addFU.ps1 = cpu->iq_sched.ps1_tag[cpu->addfu_ready_insn];
 
-            case OPCODE_STOREP:
-            {
-                // printf("\nSTOREP: ps1-valid: %d, broadcast = %d\n", cpu->cpu_prf[cpu->rename_dispatch.ps1].isValid, cpu->intFU_broadcasted_tag);
-                if (cpu->cpu_prf[cpu->rename_dispatch.ps1].isValid || 
-                    cpu->rename_dispatch.ps1 == cpu->intFU_broadcasted_tag || 
-                    cpu->rename_dispatch.ps1 == cpu->mulFU_broadcasted_tag) {
-                    cpu->godzilla.ps1_valid = TRUE;
-                }
-                else {
-                    cpu->godzilla.ps1_valid = FALSE;
                 }
+                else if (cpu->mulFU_broadcasted_tag == cpu->iq_sched.ps1_tag[cpu->addfu_ready_insn]) {
+                    cpu->execute.addFU.ps1_value = cpu->mulFU_broadcasted_value;
+                    cpu->execute.addFU.ps1 = cpu->iq_sched.ps1_tag[cpu->addfu_ready_insn];
+                    cpu->execute.addFU.forwarded_from_mul = 1;
 
-                if (cpu->cpu_prf[cpu->rename_dispatch.ps2].isValid || 
-                    cpu->rename_dispatch.ps2 == cpu->intFU_broadcasted_tag || 
-                    cpu->rename_dispatch.ps2 == cpu->mulFU_broadcasted_tag) {
-                    cpu->godzilla.ps2_valid = TRUE;
                 }
                 else {
-                    cpu->godzilla.ps2_valid = FALSE;
-                }
-
-                printf("\nlpsp_inc_dest in rename_dispatch = %d\n", cpu->rename_dispatch.lpsp_inc_dest);
-                cpu->godzilla.lpsp_inc_dest = cpu->rename_dispatch.lpsp_inc_dest;
+                    cpu->execute.addFU.ps1 = cpu->iq_sched.ps1_tag[cpu->addfu_ready_insn];
+                    cpu->execute.addFU.ps1_value = cpu->cpu_prf[cpu->iq_sched.ps1_tag[cpu->addfu_ready_insn]].value;
 
-                break;
+                }
             }
+            else {
+                if (cpu->intFU_broadcasted_tag == cpu->iq_sched.ps2_tag[cpu->addfu_ready_insn]) {
+                    cpu->execute.addFU.ps2_value = cpu->intFU_broadcasted_value;
+                    cpu->execute.addFU.ps2 = cpu->iq_sched.ps2_tag[cpu->addfu_ready_insn];
 
-            case OPCODE_LOAD:
-            case OPCODE_ADDL:
-            case OPCODE_SUBL:
-            case OPCODE_CML:
-            {
-                if (cpu->cpu_prf[cpu->rename_dispatch.ps1].isValid || 
-                    cpu->rename_dispatch.ps1 == cpu->intFU_broadcasted_tag || 
-                    cpu->rename_dispatch.ps1 == cpu->mulFU_broadcasted_tag) {
-                    cpu->godzilla.ps1_valid = TRUE;
-                }
-                else {
-                    cpu->godzilla.ps1_valid = FALSE;
                 }
+                else if (cpu->mulFU_broadcasted_tag == cpu->iq_sched.ps2_tag[cpu->addfu_ready_insn]) {
+                    cpu->execute.addFU.ps2_value = cpu->mulFU_broadcasted_value;
+                    cpu->execute.addFU.ps2 = cpu->iq_sched.ps2_tag[cpu->addfu_ready_insn];
+                    cpu->execute.addFU.forwarded_from_mul = 2;
 
-                cpu->godzilla.ps2_valid = TRUE;
-
-                break;
-            }
-
-            case OPCODE_LOADP:
-            {
-                if (cpu->cpu_prf[cpu->rename_dispatch.ps1].isValid || 
-                    cpu->rename_dispatch.ps1 == cpu->intFU_broadcasted_tag || 
-                    cpu->rename_dispatch.ps1 == cpu->mulFU_broadcasted_tag) {
-                    cpu->godzilla.ps1_valid = TRUE;
                 }
                 else {
-                    cpu->godzilla.ps1_valid = FALSE;
+                    cpu->execute.addFU.ps2 = cpu->iq_sched.ps2_tag[cpu->addfu_ready_insn];
+                    cpu->execute.addFU.ps2_value = cpu->cpu_prf[cpu->iq_sched.ps2_tag[cpu->addfu_ready_insn]].value;
+
                 }
+            }
 
-                cpu->godzilla.ps2_valid = TRUE;
+            // if (cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag &&
+            //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag) {
+            //     cpu->execute.intFU.ps1 = cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag;
+            //     cpu->execute.intFU.ps1_value = cpu->cpu_prf[cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag].value;
 
-                cpu->godzilla.lpsp_inc_dest = cpu->rename_dispatch.lpsp_inc_dest;
+            //     cpu->cpu_prf[cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->intfu_ready_insn].ps1_tag] = 0;
+            // }
 
-                break;
-            }
+            cpu->execute.addFU.imm = cpu->cpu_iq[cpu->addfu_ready_insn].literal;
+            cpu->execute.addFU.opcode = cpu->cpu_iq[cpu->addfu_ready_insn].function_type;
 
-            case OPCODE_MOVC:
-            {
-                cpu->godzilla.ps1_valid = TRUE;
-                cpu->godzilla.ps2_valid = TRUE;
+            iq_release_entry(cpu, cpu->addfu_ready_insn);
+            cpu->addfu_ready_insn = -1;
 
-                break;
-            }
+            // // printf("\nexecute: pd: %d, ps1: %d\n", cpu->execute.addFU.pd, cpu->execute.addFU.ps1);
         }
 
-        if(cpu->rename_dispatch.opcode == OPCODE_HALT)
-        {
-            cpu->godzilla.ps1_valid = TRUE;
-            cpu->godzilla.ps2_valid = TRUE;
+        if (cpu->mulfu_ready_insn != -1) {
+            cpu->execute.mulFU.has_insn = TRUE;
+            cpu->execute.mulFU.seq = cpu->cpu_iq[cpu->mulfu_ready_insn].seq;
+            cpu->execute.mulFU.thread = cpu->cpu_iq[cpu->mulfu_ready_insn].thread;
+            trace_stage(cpu, cpu->execute.mulFU.seq, PIPEVIEW_ISSUE);
 
-            cpu->rename_dispatch.has_insn = FALSE;
-        }
+            cpu->execute.mulFU.pd = cpu->cpu_iq[cpu->mulfu_ready_insn].dest;
+            cpu->execute.mulFU.cc_tag = cpu->cpu_iq[cpu->mulfu_ready_insn].cc_dest;
+            
+            if (cpu->mulFU_broadcasted_tag == cpu->iq_sched.ps1_tag[cpu->mulfu_ready_insn]) {
+                cpu->execute.mulFU.ps1_value = cpu->mulFU_broadcasted_value;
+                cpu->execute.mulFU.ps1 = cpu->iq_sched.ps1_tag[cpu->mulfu_ready_insn];
+                cpu->execute.mulFU.forwarded_from_mul = 1;
 
-        if (ENABLE_DEBUG_MESSAGES)
-        {
-            print_stage_content("Decode2", &cpu->rename_dispatch);
-        }
-    }
 
-    return FALSE;
-}
+                // printf("\n1. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
+            }
+            else if (cpu->intFU_broadcasted_tag == cpu->iq_sched.ps1_tag[cpu->mulfu_ready_insn]) {
+                cpu->execute.mulFU.ps1_value = cpu->intFU_broadcasted_value;
+                cpu->execute.mulFU.ps1 = cpu->iq_sched.ps1_tag[cpu->mulfu_ready_insn];
 
-#pragma region - Godzilla Stage 
 
-/*
-This method sets the flag enter_godzilla to denote if dispatch should stall
-*/
-void should_dispatch_stall (APEX_CPU *cpu) {
-    int entry_available_in_iq = 0;
-    int entry_available_in_rob = 0;
-    int entry_available_in_lsq = 0;
-    int entry_available_in_bq = 0;
-    int entry_available_in_bis = 0;
+                // printf("\n2. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
+            }
+            else {
+                cpu->execute.mulFU.ps1 = cpu->iq_sched.ps1_tag[cpu->mulfu_ready_insn];
+                cpu->execute.mulFU.ps1_value = cpu->cpu_prf[cpu->iq_sched.ps1_tag[cpu->mulfu_ready_insn]].value;
+                cpu->execute.mulFU.ps1 = cpu->iq_sched.ps1_tag[cpu->mulfu_ready_insn];
 
-    for (int i = 0; i < IQ_SIZE; i++) {
-        if (cpu->cpu_iq[i].isValid != TRUE) {
-            entry_available_in_iq = 1;
-            break;
-        }
-    }
 
-    if (entry_available_in_iq == 0) {
-        cpu->godzilla.enter_godzilla = FALSE;
-        return;
-    }
+                // printf("\n3. Mul insn being sent: pd[%d], ps1[%d]: %d, ps2[%d]: %d\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps1_value, cpu->execute.mulFU.ps2, cpu->execute.mulFU.ps2_value);
+            }
 
-    if (cpu->rob_head == cpu->rob_tail && cpu->cpu_rob[cpu->rob_head].isValid) {
-        cpu->godzilla.enter_godzilla = FALSE;
-        return;
-    }
+            if (cpu->mulFU_broadcasted_tag == cpu->iq_sched.ps2_tag[cpu->mulfu_ready_insn]) {
+                cpu->execute.mulFU.ps2_value = cpu->mulFU_broadcasted_value;
+                cpu->execute.mulFU.ps2 = cpu->iq_sched.ps2_tag[cpu->mulfu_ready_insn];
+                cpu->execute.mulFU.forwarded_from_mul = 2;
 
-    // for (int i = 0; i < ROB_SIZE; i++) {
-    //     if (cpu->cpu_rob[i].isValid != TRUE) {
-    //         entry_available_in_rob = 1;
-    //         break;
-    //     }
-    // }
 
-    // if (entry_available_in_rob == 0) {
-    //     cpu->godzilla.enter_godzilla = FALSE;
-    //     return;
-    // }
+                // printf("\n4. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
+            }
+            else if (cpu->intFU_broadcasted_tag == cpu->iq_sched.ps2_tag[cpu->mulfu_ready_insn]) {
+                cpu->execute.mulFU.ps2_value = cpu->intFU_broadcasted_value;
+                cpu->execute.mulFU.ps2 = cpu->iq_sched.ps2_tag[cpu->mulfu_ready_insn];
 
-    if (cpu->rename_dispatch.opcode == OPCODE_LOAD || 
-        cpu->rename_dispatch.opcode == OPCODE_STORE || 
-        cpu->rename_dispatch.opcode == OPCODE_LOADP || 
-        cpu->rename_dispatch.opcode == OPCODE_STOREP) {
-        if (cpu->lsq_head == cpu->lsq_tail && cpu->cpu_lsq[cpu->lsq_head].isValid) {
-            cpu->godzilla.enter_godzilla = FALSE;
-            return;
-        }
-        // for (int i = 0; i < LSQ_SIZE; i++) {
-        //     if (cpu->cpu_lsq[i].isValid != TRUE) {
-        //         entry_available_in_lsq = 1;
-        //         break;
-        //     }
-        // }
 
-        // if (entry_available_in_lsq == 0) {
-        //     cpu->godzilla.enter_godzilla = FALSE;
-        //     return;
-        // }
-    }
+                // printf("\n5. Mul insn being sent: pd[%d], ps1[%d]: %d, ps2[%d]: %d\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps1_value, cpu->execute.mulFU.ps2, cpu->execute.mulFU.ps2_value);            
+                }
+            else {
+                cpu->execute.mulFU.ps2 = cpu->iq_sched.ps2_tag[cpu->mulfu_ready_insn];
+                cpu->execute.mulFU.ps2_value = cpu->cpu_prf[cpu->iq_sched.ps2_tag[cpu->mulfu_ready_insn]].value;
+                cpu->execute.mulFU.ps2 = cpu->iq_sched.ps2_tag[cpu->mulfu_ready_insn];
 
-    if (cpu->rename_dispatch.opcode == OPCODE_BNP || 
-        cpu->rename_dispatch.opcode == OPCODE_BNZ || 
-        cpu->rename_dispatch.opcode == OPCODE_BP || 
-        cpu->rename_dispatch.opcode == OPCODE_BZ || 
-        cpu->rename_dispatch.opcode == OPCODE_JUMP || 
-        cpu->rename_dispatch.opcode == OPCODE_JALR) {
-            // Yet to implement for branch instructions
-    }
 
-    cpu->godzilla.enter_godzilla = TRUE;
-    if (cpu->godzilla.opcode == OPCODE_HALT)
-    {
-        cpu->godzilla.enter_godzilla = FALSE;
-    }
-}
+                // printf("\n6. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
+            }
 
-/*
-This method is used to setup an entry in the LSQ
-*/
-void setup_entry_in_lsq (APEX_CPU *cpu) {
-    cpu->cpu_lsq[cpu->lsq_tail].dest = cpu->godzilla.pd;
-    cpu->cpu_lsq[cpu->lsq_tail].mem_valid = FALSE;
-    cpu->cpu_lsq[cpu->lsq_tail].lORs = (cpu->godzilla.opcode == OPCODE_LOAD || cpu->godzilla.opcode == OPCODE_LOADP) ? 1 : 0;
-    cpu->cpu_lsq[cpu->lsq_tail].ps1_tag = cpu->godzilla.ps1;
-    cpu->cpu_lsq[cpu->lsq_tail].ps1_valid = cpu->godzilla.ps1_valid;
-    cpu->cpu_lsq[cpu->lsq_tail].ps2_tag = cpu->godzilla.ps2;
-    cpu->cpu_lsq[cpu->lsq_tail].ps2_valid = cpu->godzilla.ps2_valid;
-    cpu->cpu_lsq[cpu->lsq_tail].pd = cpu->godzilla.pd;
-    cpu->cpu_lsq[cpu->lsq_tail].isValid = TRUE;
-    cpu->godzilla.lsq_index = cpu->lsq_tail;
-    cpu->lsq_tail = (cpu->lsq_tail + 1) % LSQ_SIZE;
-}
+            // if (cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->mulfu_ready_insn].ps1_tag &&
+            //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->mulfu_ready_insn].ps1_tag &&
+            //     cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->mulfu_ready_insn].ps2_tag &&
+            //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->mulfu_ready_insn].ps2_tag) {
+            //     cpu->execute.intFU.ps1 = cpu->cpu_iq[cpu->mulfu_ready_insn].ps1_tag;
+            //     cpu->execute.intFU.ps2 = cpu->cpu_iq[cpu->mulfu_ready_insn].ps2_tag;
+            //     cpu->execute.intFU.ps1_value = cpu->cpu_prf[cpu->cpu_iq[cpu->mulfu_ready_insn].ps1_tag].value;
+            //     cpu->execute.intFU.ps2_value = cpu->cpu_prf[cpu->cpu_iq[cpu->mulfu_ready_insn].ps2_tag].value;
 
-/*
-This method is used to setup an entry in the ROB
-*/
-void setup_entry_in_rob(APEX_CPU *cpu) {
-    cpu->cpu_rob[cpu->rob_tail].overwritten_pd = cpu->godzilla.overwritten_pd;
-    cpu->cpu_rob[cpu->rob_tail].pc = cpu->godzilla.pc;
-    cpu->cpu_rob[cpu->rob_tail].pd = cpu->godzilla.pd;
-    cpu->cpu_rob[cpu->rob_tail].rd = cpu->godzilla.rd;
-    cpu->cpu_rob[cpu->rob_tail].lsq_index = cpu->godzilla.lsq_index;
-    // cpu->cpu_rob[cpu->rob_tail].insn_type = cpu->godzilla.lsq_index != -1 ? dest_load_store : 0;
-    if (cpu->godzilla.lsq_index != -1) {
-        cpu->cpu_rob[cpu->rob_tail].insn_type = dest_load_store;
-    }
-    else if (cpu->godzilla.opcode == OPCODE_HALT) {
-        cpu->cpu_rob[cpu->rob_tail].insn_type = dest_halt;
-    }
-    else {
-        cpu->cpu_rob[cpu->rob_tail].insn_type = 0;
-    }
-    cpu->cpu_rob[cpu->rob_tail].isValid = TRUE;
-    cpu->rob_tail = (cpu->rob_tail + 1) % ROB_SIZE;
-}
+            //     cpu->cpu_prf[cpu->cpu_iq[cpu->mulfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->mulfu_ready_insn].ps1_tag] = 0;
+            //     cpu->cpu_prf[cpu->cpu_iq[cpu->mulfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->mulfu_ready_insn].ps2_tag] = 0;
 
-/*
-This method is used to setup an entry in the IQ
-*/
-void setup_entry_in_iq(APEX_CPU *cpu) {
-    // // printf("Setting up entry in IQ");
-    for (int i = 0; i < IQ_SIZE; i++) {
-        if (cpu->cpu_iq[i].isValid == FALSE) {
-            cpu->cpu_iq[i].dest = cpu->godzilla.pd;
-            printf("\ngodzilla pd = %d\n", cpu->cpu_iq[i].dest);
-            cpu->cpu_iq[i].literal = cpu->godzilla.imm;
-            cpu->cpu_iq[i].ps1_tag = cpu->godzilla.ps1;
-            if (cpu->cpu_prf[cpu->cpu_iq[i].ps1_tag].isValid) {
-                cpu->cpu_iq[i].ps1_valid = TRUE;
-            }
-            else {
-                cpu->cpu_iq[i].ps1_valid = cpu->godzilla.ps1_valid;
-            }
-            // cpu->cpu_iq[i].ps1_valid = cpu->godzilla.ps1_valid;
-            cpu->cpu_iq[i].ps2_tag = cpu->godzilla.ps2;
-            if (cpu->cpu_prf[cpu->cpu_iq[i].ps2_tag].isValid) {
-                cpu->cpu_iq[i].ps2_valid = TRUE;
-            }
-            else {
-                cpu->cpu_iq[i].ps2_valid = cpu->godzilla.ps2_valid;
-            }
-            // cpu->cpu_iq[i].ps2_valid = cpu->godzilla.ps2_valid;
-            cpu->cpu_iq[i].clock_cycle_at_dispatch = cpu->clock;
-            cpu->cpu_iq[i].function_type = cpu->godzilla.opcode;
+            //     // printf("\n5. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
+            // }
 
-            if (cpu->godzilla.opcode == OPCODE_HALT) {
-                cpu->cpu_iq[i].FU = INT_FU;
-            }
-            
-            if (cpu->godzilla.opcode == OPCODE_BNP || 
-                cpu->godzilla.opcode == OPCODE_BNZ || 
-                cpu->godzilla.opcode == OPCODE_BP || 
-                cpu->godzilla.opcode == OPCODE_BZ || 
-                cpu->godzilla.opcode == OPCODE_JUMP || 
-                cpu->godzilla.opcode == OPCODE_JALR) {
-                    // Yet to implement for branch instructions
-            }
-            else if (cpu->godzilla.opcode == OPCODE_LOAD) {
-                cpu->cpu_iq[i].dest_type = dest_load_store;
-                cpu->cpu_iq[i].dest = cpu->godzilla.lsq_index;
-                cpu->cpu_iq[i].FU = ADD_FU;
-                cpu->cpu_iq[i].ps2_valid = TRUE;
-                
-                // cpu->cpu_prf[cpu->godzilla.ps1].lsq_dependency_list[cpu->lsq_tail - 1] = 1;
-                cpu->cpu_prf[cpu->godzilla.ps1].iq_dependency_list[i] = 1;
-                // cpu->cpu_prf[cpu->godzilla.ps2].iq_dependency_list[i] = 1;
-            }
-            else if (cpu->godzilla.opcode == OPCODE_STORE) {
-                cpu->cpu_iq[i].dest_type = dest_load_store;
-                cpu->cpu_iq[i].dest = cpu->godzilla.lsq_index;
-                cpu->cpu_iq[i].FU = ADD_FU;
-                cpu->cpu_iq[i].ps1_valid = TRUE;
-                
-                cpu->cpu_prf[cpu->godzilla.ps1].lsq_dependency_list[cpu->lsq_tail - 1] = 1;
-                // cpu->cpu_prf[cpu->godzilla.ps1].iq_dependency_list[i] = 1;
-                cpu->cpu_prf[cpu->godzilla.ps2].iq_dependency_list[i] = 1;
-            }
-            else if (cpu->godzilla.opcode == OPCODE_LOADP) {
-                cpu->cpu_iq[i].dest_type = dest_loadp_storep;
-                cpu->cpu_iq[i].dest = cpu->godzilla.lsq_index;
-                cpu->cpu_iq[i].FU = ADD_FU;
-                cpu->cpu_iq[i].lpsp_inc_dest = cpu->godzilla.lpsp_inc_dest;
-                printf("\nlpsp_inc_dest in godzilla = %d\n", cpu->cpu_iq[i].lpsp_inc_dest);
-                cpu->cpu_iq[i].ps2_valid = TRUE;
-                
-                cpu->cpu_prf[cpu->godzilla.ps1].iq_dependency_list[i] = 1;
-            }
-            else if (cpu->godzilla.opcode == OPCODE_STOREP) {
-                cpu->cpu_iq[i].dest_type = dest_loadp_storep;
-                cpu->cpu_iq[i].dest = cpu->godzilla.lsq_index;
-                cpu->cpu_iq[i].FU = ADD_FU;
-                cpu->cpu_iq[i].lpsp_inc_dest = cpu->godzilla.lpsp_inc_dest;
-                printf("\nlpsp_inc_dest in godzilla = %d\n", cpu->cpu_iq[i].lpsp_inc_dest);
-                cpu->cpu_iq[i].ps1_valid = TRUE;
-                
-                cpu->cpu_prf[cpu->godzilla.ps2].iq_dependency_list[i] = 1;
-                cpu->cpu_prf[cpu->godzilla.ps1].lsq_dependency_list[cpu->lsq_tail - 1] = 1;
-            }
-            else {
-                cpu->cpu_iq[i].dest = cpu->godzilla.pd;
-
-                // cpu->cpu_prf[cpu->godzilla.pd].iq_dependency_list[i] = 1;
-
-                switch (cpu->godzilla.opcode) {
-                    case OPCODE_ADD:
-                    case OPCODE_SUB:
-                    case OPCODE_AND:
-                    case OPCODE_OR:
-                    case OPCODE_XOR:
-                    case OPCODE_CMP:
-                    {
-                        cpu->cpu_prf[cpu->godzilla.ps1].iq_dependency_list[i] = 1;
-                        cpu->cpu_prf[cpu->godzilla.ps2].iq_dependency_list[i] = 1;
-                        cpu->cpu_iq[i].FU = INT_FU;
-
-                        break;
-                    }
+            iq_release_entry(cpu, cpu->mulfu_ready_insn);
+            cpu->execute.mulFU.opcode = cpu->cpu_iq[cpu->mulfu_ready_insn].function_type;
+            cpu->mulfu_ready_insn = -1;
 
-                    case OPCODE_ADDL:
-                    case OPCODE_SUBL:
-                    case OPCODE_CML:
-                    {
-                        cpu->cpu_prf[cpu->godzilla.ps1].iq_dependency_list[i] = 1;
-                        cpu->cpu_iq[i].FU = INT_FU;
+            // // printf("\nexecute: pd: %d, ps1: %d, ps2: %d\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
+        }
 
-                        break;
-                    }
+        if (cpu->divfu_ready_insn != -1) {
+            int i = cpu->divfu_ready_insn;
+
+            cpu->execute.divFU.has_insn = TRUE;
+            cpu->execute.divFU.seq = cpu->cpu_iq[i].seq;
+            cpu->execute.divFU.thread = cpu->cpu_iq[i].thread;
+            trace_stage(cpu, cpu->execute.divFU.seq, PIPEVIEW_ISSUE);
+
+            cpu->execute.divFU.pd = cpu->cpu_iq[i].dest;
+            cpu->execute.divFU.cc_tag = cpu->cpu_iq[i].cc_dest;
+            cpu->execute.divFU.pc = cpu->cpu_iq[i].pc;
+            cpu->execute.divFU.rob_index = cpu->cpu_iq[i].rob_index;
+            cpu->execute.divFU.ps1 = cpu->iq_sched.ps1_tag[i];
+            cpu->execute.divFU.ps2 = cpu->iq_sched.ps2_tag[i];
+            cpu->execute.divFU.ps1_value = issue_operand_value(cpu, cpu->execute.divFU.ps1);
+            cpu->execute.divFU.ps2_value = issue_operand_value(cpu, cpu->execute.divFU.ps2);
+            cpu->execute.divFU.opcode = cpu->cpu_iq[i].function_type;
+
+            iq_release_entry(cpu, i);
+            cpu->divfu_ready_insn = -1;
+        }
+        HOST_PROFILE_LAP(cpu, PROF_GODZILLA_ISSUE);
 
-                    case OPCODE_LOAD:
-                    case OPCODE_LOADP:
-                    {
-                        cpu->cpu_prf[cpu->godzilla.ps1].iq_dependency_list[i] = 1;
-                        cpu->cpu_iq[i].FU = ADD_FU;
+        if (cpu->addFU_broadcasted_tag != -1) {
+            CPU_LSQ *lsq_entry = &cpu->threads[cpu->addFU_broadcasted_thread].cpu_lsq[cpu->addFU_broadcasted_tag];
 
-                        break;
-                    }
+            lsq_entry->memory = cpu->addFU_broadcasted_value;
+            lsq_entry->mem_valid = TRUE;
 
-                    case OPCODE_STORE:
-                    case OPCODE_STOREP:
-                    {
-                        cpu->cpu_prf[cpu->godzilla.ps1].iq_dependency_list[i] = 1;
-                        cpu->cpu_prf[cpu->godzilla.ps2].iq_dependency_list[i] = 1;
-                        cpu->cpu_iq[i].FU = ADD_FU;
+            cpu->addFU_broadcasted_tag = -1;
+        }
 
-                        break;
-                    }
+        // printf("\nBroadcasted tag is: %d[%d] -> value is: %d\n", cpu->intFU_broadcasted_tag, cpu->cpu_prf[cpu->intFU_broadcasted_tag].isValid, cpu->intFU_broadcasted_value);
+        if (cpu->intFU_broadcasted_tag != -1) {
+            cpu->cpu_prf[cpu->intFU_broadcasted_tag].isValid = TRUE;
+            cpu->cpu_prf[cpu->intFU_broadcasted_tag].value = cpu->intFU_broadcasted_value;
+
+            // // printf("\nUpdated prf: prf[%d[%d]] = %d\n", cpu->intFU_broadcasted_tag, cpu->cpu_prf[cpu->intFU_broadcasted_tag].isValid, cpu->cpu_prf[cpu->intFU_broadcasted_tag].value);
+        }
+        if (cpu->mulFU_broadcasted_tag != -1 && cpu->execute.mulFU_clock == 0) {
+            cpu->cpu_prf[cpu->mulFU_broadcasted_tag].isValid = TRUE;
+            cpu->cpu_prf[cpu->mulFU_broadcasted_tag].value = cpu->mulFU_broadcasted_value;
+        }
 
-                    case OPCODE_MOVC:
-                    {
-                        cpu->cpu_iq[i].FU = INT_FU;
+        /* The thread committing first, and so first to get the memory port, changes every cycle */
+        for (int n = 0; n < cpu->thread_count; n++) {
+            cpu->thread = &cpu->threads[(cpu->clock + n) % cpu->thread_count];
+            if (cpu->thread->godzilla.has_insn) {
+                godzilla_commit(cpu);
+            }
+        }
 
-                        break;
-                    }
+        if (cpu->intFU_broadcasted_tag != -1) {
+            // printf("\nUpdated prf: prf[%d[%d]] = %d\n", cpu->intFU_broadcasted_tag, cpu->cpu_prf[cpu->intFU_broadcasted_tag].isValid, cpu->cpu_prf[cpu->intFU_broadcasted_tag].value);
+        }
 
-                    case OPCODE_MUL:
-                    {
-                        cpu->cpu_prf[cpu->godzilla.ps1].iq_dependency_list[i] = 1;
-                        cpu->cpu_prf[cpu->godzilla.ps2].iq_dependency_list[i] = 1;
-                        cpu->cpu_iq[i].FU = MUL_FU;
+        cpu->intFU_broadcasted_tag = -1;
+        cpu->mulFU_broadcasted_tag = -1;
+        cpu->addFU_broadcasted_tag = -1;
 
-                        break;
-                    }
-                }
+        for (int t = 0; t < cpu->thread_count; t++) {
+            cpu->thread = &cpu->threads[t];
+            if (!cpu->thread->godzilla.has_insn) {
+                continue;
             }
 
-            cpu->cpu_iq[i].isValid = TRUE;
+#if PRF_EARLY_RELEASE
+            release_dead_regs(cpu);
+#endif
+            HOST_PROFILE_LAP(cpu, PROF_GODZILLA_COMMIT);
 
-            break;
+            should_dispatch_stall(cpu);
+            HOST_PROFILE_LAP(cpu, PROF_GODZILLA_ALLOCATE);
+
+
+            if (cpu->debug_messages) {
+                print_godzilla(cpu);
+            }
         }
     }
 }
 
+#pragma endregion - Godzilla Stage
+
+#pragma region - Execute Stage 
+
 /*
-This method is used to wakeup instructions after tag broadcast
+This method writes the flags of a result to a condition code register and puts its tag on the wakeup bus
 */
-void wakeup_instructions (APEX_CPU *cpu, int tag) {
-    // // printf("\nWaking up instructions\n");
+static void write_flags (APEX_CPU *cpu, int cc, int result) {
+    cpu->cpu_cprf[cc].value = result_flags(result);
+    cpu->cpu_cprf[cc].isValid = TRUE;
 
-    int clock_max_intfu = INT32_MAX;
-    int clock_max_addfu = INT32_MAX;
-    int clock_max_mulfu = INT32_MAX;
+    broadcast_tag(cpu, CC_TAG(cc));
+}
 
-    // printf("\nBroadcasted tag: %d\n", tag);
-    if (tag != -1) {
-        // for (int i = 0; i < IQ_SIZE; i++) {
-        //     if (cpu->cpu_prf[tag].iq_dependency_list[i] == 1) {
-        //         // printf("\nMul check: ps1[%d], ps2[%d], tag[%d]\n", cpu->cpu_iq[i].ps1_tag, cpu->cpu_iq[i].ps2_tag, tag);
-        //         printf("\nSTOREP: ps1-valid: %d, broadcast = %d\n", cpu->cpu_prf[cpu->cpu_iq[i].ps1_tag].isValid, tag);
-        //         if (cpu->cpu_iq[i].ps1_tag == tag) {
-        //             cpu->cpu_iq[i].ps1_valid = TRUE;
-        //         }
+/*
+This method compares the resolved next PC of the branch in the INT FU with the one fetch went on
+with, and flushes the younger instructions when they differ. The checkpoint of the branch is freed.
+*/
+static void resolve_branch (APEX_CPU *cpu, int next_pc) {
+    int rob_index = cpu->execute.intFU.rob_index;
+    CPU_ROB *entry = &cpu->thread->cpu_rob[rob_index];
+
+    if (is_indirect_jump(cpu->execute.intFU.opcode) && entry->pred_source == TARGET_PRED_NONE) {
+        /* Fetch waited for this one, nothing was fetched past it */
+        cpu->thread->pc = next_pc;
+        cpu->thread->branch_in_flight = FALSE;
+    }
+    else if (entry->pred_target != next_pc) {
+        flush_younger(cpu, rob_index, next_pc);
+        cpu->stats.branch_mispredicts++;
+    }
 
-        //         if (cpu->cpu_iq[i].ps2_tag == tag) {
-        //             cpu->cpu_iq[i].ps2_valid = TRUE;
-        //         }
-        //     }
-        // }
+    cpu->thread->checkpoints[entry->checkpoint].isValid = FALSE;
+}
 
-        printf("\nBroadcasted tag = %d\n", tag);
-        for (int i = 0; i < IQ_SIZE; i++) {
-            // printf("\nis valid = %d for %d\n", cpu->cpu_iq[i].isValid, i);
-            if (cpu->cpu_iq[i].isValid) {
-                printf("\nIQ check: ps1 = %d, tag = %d\n", cpu->cpu_iq[i].ps1_tag, tag);
-                if (cpu->cpu_iq[i].ps1_tag == tag) {
-                    cpu->cpu_iq[i].ps1_valid = TRUE;
-                }
-                printf("\nIQ check: ps2 = %d, tag = %d\n", cpu->cpu_iq[i].ps2_tag, tag);
-                if (cpu->cpu_iq[i].ps2_tag == tag) {
-                    cpu->cpu_iq[i].ps2_valid = TRUE;
-                }
-            }
-        }
+/*
+This method scores the target predicted at fetch for the JUMP/JALR in the INT FU, trains the
+indirect-target table and resolves the jump to its target
+*/
+static void resolve_indirect_jump (APEX_CPU *cpu, int target) {
+    const CPU_ROB *entry = &cpu->thread->cpu_rob[cpu->execute.intFU.rob_index];
+    int correct = entry->pred_target == target;
+
+    switch (entry->pred_source) {
+        case TARGET_PRED_RAS:
+            cpu->stats.ras_predictions++;
+            cpu->stats.ras_correct += correct;
+            break;
 
-        for (int i = cpu->lsq_head; i != cpu->lsq_tail; i = (i + 1) % LSQ_SIZE) {
-            // printf("\nSTOREP: ps1-valid: %d, broadcast = %d\n", cpu->cpu_prf[cpu->cpu_iq[i].ps1_tag].isValid, cpu->intFU_broadcasted_tag);
-            if (cpu->cpu_lsq[i].ps1_tag == tag) {
-                cpu->cpu_lsq[i].ps1_valid = TRUE;
-            }
-        }
-    }
-    else {
-        for (int i = 0; i < IQ_SIZE; i++) {
-            if (cpu->cpu_iq[i].isValid) {
-                if (cpu->cpu_prf[cpu->cpu_iq[i].ps1_tag].isValid) {
-                    cpu->cpu_iq[i].ps1_valid = TRUE;
-                }
-                if (cpu->cpu_prf[cpu->cpu_iq[i].ps2_tag].isValid) {
-                    cpu->cpu_iq[i].ps2_valid = TRUE;
-                }
-            }
-        }
+        case TARGET_PRED_ITT:
+            cpu->stats.itt_predictions++;
+            cpu->stats.itt_correct += correct;
+            break;
+
+        default:
+            cpu->stats.indirect_unpredicted++;
+            break;
     }
 
-    for (int i = 0; i < IQ_SIZE; i++) {
-        if (cpu->cpu_iq[i].isValid && cpu->cpu_iq[i].FU == INT_FU) {
-            if (cpu->cpu_iq[i].ps1_valid && cpu->cpu_iq[i].ps2_valid && cpu->execute.intFU.has_insn == FALSE) {
-                if (cpu->cpu_iq[i].clock_cycle_at_dispatch < clock_max_intfu) {
-                    clock_max_intfu = cpu->cpu_iq[i].clock_cycle_at_dispatch;
+    target_predictor_train(&cpu->thread->target_pred, cpu->execute.intFU.pc, target);
 
-                    cpu->godzilla.intfu_ready_insn = i;
+    resolve_branch(cpu, target);
+}
 
-                    // // printf("\ninsn woken up: iq[%d]\n", i);
-                }
-            }
-        }
+/*
+This method returns TRUE if the conditional branch is taken with the given flags
+*/
+static int branch_taken (int opcode, int flags) {
+    switch (opcode) {
+        case OPCODE_BZ:
+            return (flags & FLAG_ZERO) != 0;
+        case OPCODE_BNZ:
+            return (flags & FLAG_ZERO) == 0;
+        case OPCODE_BP:
+            return (flags & FLAG_POSITIVE) != 0;
+        case OPCODE_BNP:
+            return (flags & FLAG_POSITIVE) == 0;
+        case OPCODE_BN:
+            return (flags & FLAG_NEGATIVE) != 0;
+        case OPCODE_BNN:
+            return (flags & FLAG_NEGATIVE) == 0;
     }
 
-    // printf("\nintfu_ready_insn: %d\n", cpu->godzilla.intfu_ready_insn);
+    return FALSE;
+}
 
-    for (int i = 0; i < IQ_SIZE; i++) {
-        if (cpu->cpu_iq[i].isValid && cpu->cpu_iq[i].FU == ADD_FU) {
-            if (cpu->cpu_iq[i].ps1_valid && cpu->cpu_iq[i].ps2_valid && cpu->execute.addFU.has_insn == FALSE) {
-                if (cpu->cpu_iq[i].clock_cycle_at_dispatch < clock_max_addfu) {
-                    clock_max_addfu = cpu->cpu_iq[i].clock_cycle_at_dispatch;
+/*
+This method resolves the conditional branch at pc, executed in the INT FU on the given flags
+*/
+static void resolve_conditional_branch (APEX_CPU *cpu, int opcode, int pc, int offset, int flags) {
+    int next_pc = pc + 4;
 
-                    cpu->godzilla.addfu_ready_insn = i;
-                }
-            }
-        }
+    if (branch_taken(opcode, flags)) {
+        next_pc = pc + offset;
+        cpu->stats.branches_taken++;
     }
 
-    for (int i = 0; i < IQ_SIZE; i++) {
-        if (cpu->cpu_iq[i].isValid && cpu->cpu_iq[i].FU == MUL_FU) {
-            if (cpu->cpu_iq[i].ps1_valid && cpu->cpu_iq[i].ps2_valid && cpu->execute.mulFU.has_insn == FALSE) {
-                if (cpu->cpu_iq[i].clock_cycle_at_dispatch < clock_max_mulfu) {
-                    clock_max_mulfu = cpu->cpu_iq[i].clock_cycle_at_dispatch;
-
-                    cpu->godzilla.mulfu_ready_insn = i;
+    cpu->stats.branches++;
+    cpu->thread->cpu_rob[cpu->execute.intFU.rob_index].completed = TRUE;
+    resolve_branch(cpu, next_pc);
+}
 
-                    // printf("\nPicked MUL insn: %d\n", i);
-                }
-            }
+/*
+This function is used to implement the Integer FU of the execute stage
+*/
+void run_intFU (APEX_CPU *cpu) {
+    if (cpu->execute.intFU.has_insn) {
+        if (cpu->execute.intFU.forwarded_from_mul == 1) {
+            cpu->execute.intFU.ps1_value = cpu->mulFU_broadcasted_value;
+            cpu->execute.intFU.forwarded_from_mul = 0;
+            // printf("\nEXEC - MUL forwarded value: %d\n", cpu->execute.intFU.ps1_value);
         }
-    }
+        else if (cpu->execute.intFU.forwarded_from_mul == 2) {
+            cpu->execute.intFU.ps2_value = cpu->mulFU_broadcasted_value;
+            cpu->execute.intFU.forwarded_from_mul = 0;
+        }
+
+        switch (cpu->execute.intFU.opcode) {
+            case OPCODE_ADD:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value + cpu->execute.intFU.ps2_value;
 
-    // for (int i = 0; i < IQ_SIZE; i++) {
-    //     if (cpu->cpu_prf[tag].iq_dependency_list[i] == 1) {
-    //         if (cpu->cpu_iq[i].FU == INT_FU && cpu->cpu_iq[i].clock_cycle_at_dispatch < clock_max_intfu) {
-    //             if (cpu->cpu_iq[i].ps1_tag == tag && cpu->cpu_iq[i].ps2_valid == TRUE) {
-    //                 cpu->godzilla.intfu_ready_insn = i;
-    //                 clock_max_intfu = cpu->cpu_iq[i].clock_cycle_at_dispatch;
-    //             }
-    //             else if (cpu->cpu_iq[i].ps2_tag == tag && cpu->cpu_iq[i].ps1_valid == TRUE) {
-    //                 cpu->godzilla.intfu_ready_insn = i;
-    //                 clock_max_intfu = cpu->cpu_iq[i].clock_cycle_at_dispatch;
-    //             }
-    //         }
-    //         else if (cpu->cpu_iq[i].FU == ADD_FU && cpu->cpu_iq[i].clock_cycle_at_dispatch < clock_max_addfu) {
-    //             cpu->godzilla.addfu_ready_insn = i;
-    //             clock_max_addfu = cpu->cpu_iq[i].clock_cycle_at_dispatch;
-    //         }
-    //         else if (cpu->cpu_iq[i].FU == MUL_FU && cpu->cpu_iq[i].clock_cycle_at_dispatch < clock_max_mulfu) {
-    //             if (cpu->cpu_iq[i].ps1_tag == tag && cpu->cpu_iq[i].ps2_valid == TRUE) {
-    //                 cpu->godzilla.mulfu_ready_insn = i;
-    //                 clock_max_mulfu = cpu->cpu_iq[i].clock_cycle_at_dispatch;
-    //             }
-    //             else if (cpu->cpu_iq[i].ps2_tag == tag && cpu->cpu_iq[i].ps1_valid == TRUE) {
-    //                 cpu->godzilla.mulfu_ready_insn = i;
-    //                 clock_max_mulfu = cpu->cpu_iq[i].clock_cycle_at_dispatch;
-    //             }
-    //         }
-    //     }
-    // }
+                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
+                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
 
-    for (int i = 0; i < LSQ_SIZE; i++) {
-        if (cpu->cpu_lsq[tag].mem_valid == TRUE) {
-            if (cpu->cpu_lsq[tag].lORs == 0 && cpu->cpu_lsq[tag].ps2_valid == TRUE) {
-                cpu->godzilla.lsq_target = i;
-            }
-            else if (cpu->cpu_lsq[tag].lORs == 1) {
-                cpu->godzilla.lsq_target = i;
+                break;
             }
-        }
-    }
-}
 
-/*
-This method is used to broadcast the tags of Integer and Address Function Units
-*/
-void broadcast_tags (APEX_CPU *cpu) {
-    // // printf("\nBroadcasting tags\n");
+            case OPCODE_ADDL:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value + cpu->execute.intFU.imm;
 
-    if (cpu->execute.intFU.has_insn) {
-        cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
-        cpu->intcc_broadcast_tag = cpu->execute.intFU.cc_tag;
-    }
-    wakeup_instructions(cpu, cpu->intFU_broadcasted_tag);
+                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
+                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
 
-    if (cpu->execute.addFU.has_insn) {
-        cpu->addFU_broadcasted_tag = cpu->execute.addFU.pd;
-    }
-    wakeup_instructions(cpu, cpu->addFU_broadcasted_tag);
-}
+                break;
+            }
 
-/*
-This method is used to perform load/store operation by popping out the entry at the head of the LSQ 
-and performing the memory access operations
-*/
-void perform_load_store (APEX_CPU *cpu) {
-    if (cpu->cpu_lsq[cpu->lsq_head].mem_valid) {
-        if (cpu->cpu_lsq[cpu->lsq_head].lORs == 0) {
-            if (cpu->cpu_prf[cpu->cpu_lsq[cpu->lsq_head].ps1_tag].isValid || 
-                cpu->cpu_lsq[cpu->lsq_head].ps1_tag == cpu->intFU_broadcasted_tag || 
-                cpu->cpu_lsq[cpu->lsq_head].ps1_tag == cpu->mulFU_broadcasted_tag) {
-                cpu->godzilla.mem_stage_clock++;
-
-                if (cpu->godzilla.mem_stage_clock == 2) {
-                    if (cpu->cpu_prf[cpu->cpu_lsq[cpu->lsq_head].ps1_tag].isValid) {
-                        cpu->data_memory[cpu->cpu_lsq[cpu->lsq_head].memory] = cpu->cpu_prf[cpu->cpu_lsq[cpu->lsq_head].ps1_tag].value;
-                    }
-                    else {
-                        if (cpu->cpu_lsq[cpu->lsq_head].ps1_tag == cpu->intFU_broadcasted_tag) {
-                            cpu->data_memory[cpu->cpu_lsq[cpu->lsq_head].memory] = cpu->intFU_broadcasted_value;
-                        }
-                        else if (cpu->cpu_lsq[cpu->lsq_head].ps1_tag == cpu->mulFU_broadcasted_tag) {
-                            cpu->data_memory[cpu->cpu_lsq[cpu->lsq_head].memory] = cpu->mulFU_broadcasted_value;
-                        }
-                    }
+            case OPCODE_SUB:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value - cpu->execute.intFU.ps2_value;
 
-                    cpu->godzilla.mem_stage_clock = 0;
+                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
+                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
 
-                    cpu->cpu_lsq[cpu->lsq_head].isValid = FALSE;
-                    cpu->lsq_head = (cpu->lsq_head + 1) % LSQ_SIZE;
+                break;
+            }
 
-                    if (cpu->cpu_rob[cpu->rob_head].overwritten_pd != -1) {
-                        cpu->free_reg_list[cpu->free_reg_tail] = cpu->cpu_rob[cpu->rob_head].overwritten_pd;
-                        cpu->free_reg_tail = (cpu->free_reg_tail + 1) % PRF_SIZE;
-                    }
+            case OPCODE_SUBL:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value - cpu->execute.intFU.imm;
 
-                    if (cpu->godzilla.mem_insn_reg_updt.dest != -1) {
-                        cpu->regs[cpu->godzilla.mem_insn_reg_updt.dest] = cpu->cpu_prf[cpu->godzilla.mem_insn_reg_updt.incr_dest].value;
-                        cpu->godzilla.mem_insn_reg_updt.dest = -1;
-                    }
+                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
+                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
 
-                    cpu->cpu_rob[cpu->rob_head].isValid = FALSE;
-                    cpu->rob_head = (cpu->rob_head + 1) % ROB_SIZE;
-                }
+                break;
             }
-        }
-        else if (cpu->cpu_lsq[cpu->lsq_head].lORs == 1) {
-            cpu->godzilla.mem_stage_clock++;
+            
+            case OPCODE_OR:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value | cpu->execute.intFU.ps2_value;
 
-            if (cpu->godzilla.mem_stage_clock == 2) {
-                cpu->cpu_prf[cpu->cpu_lsq[cpu->lsq_head].pd].isValid = TRUE;
-                cpu->cpu_prf[cpu->cpu_lsq[cpu->lsq_head].pd].value = cpu->data_memory[cpu->cpu_lsq[cpu->lsq_head].memory];
+                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
+                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
 
-                cpu->godzilla.mem_stage_clock = 0;
+                break;
+            }
 
-                cpu->cpu_lsq[cpu->lsq_head].isValid = FALSE;
-                cpu->lsq_head = (cpu->lsq_head + 1) % LSQ_SIZE;
+            case OPCODE_XOR:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value ^ cpu->execute.intFU.ps2_value;
 
-                if (cpu->cpu_rob[cpu->rob_head].overwritten_pd != -1) {
-                    cpu->free_reg_list[cpu->free_reg_tail] = cpu->cpu_rob[cpu->rob_head].overwritten_pd;
-                    cpu->free_reg_tail = (cpu->free_reg_tail + 1) % PRF_SIZE;
-                }
+                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
+                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
 
-                cpu->regs[cpu->cpu_rob[cpu->rob_head].rd] = cpu->cpu_prf[cpu->cpu_lsq[cpu->lsq_head].pd].value;
-                if (cpu->godzilla.mem_insn_reg_updt.dest != -1) {
-                    cpu->regs[cpu->godzilla.mem_insn_reg_updt.dest] = cpu->cpu_prf[cpu->godzilla.mem_insn_reg_updt.incr_dest].value;
-                    cpu->godzilla.mem_insn_reg_updt.dest = -1;
-                }
+                break;
+            }
 
-                cpu->cpu_rob[cpu->rob_head].isValid = FALSE;
-                cpu->rob_head = (cpu->rob_head + 1) % ROB_SIZE;
+            case OPCODE_CMP:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value - cpu->execute.intFU.ps2_value;
 
-                printf("\nmem[%d]=%d => p[%d] = %d\n", cpu->cpu_lsq[cpu->lsq_head].memory, cpu->cpu_prf[cpu->cpu_lsq[cpu->lsq_head].pd].value, cpu->cpu_lsq[cpu->lsq_head].pd, cpu->cpu_prf[cpu->cpu_lsq[cpu->lsq_head].pd].value);
-                wakeup_instructions(cpu, cpu->cpu_lsq[cpu->lsq_head].pd);
+                break;
             }
-        }
-    }
-}
 
-/*
-This method implements:
-- setting up entries in IQ,
-- setting up entries in ROB,
-- setting up entries in LSQ,
-- setting up entries in BQ,
-- setting up entries in BIS,
-- waking up instructions for issue,
-- committing instructions from ROB,
-- making load/store accesses from LSQ
-- notifying if dispatch should stall
-*/
-static void
-APEX_Godzilla(APEX_CPU *cpu) {
-    if (cpu->godzilla.has_insn) {
-        if (cpu->godzilla.enter_godzilla == TRUE) {
-            if (cpu->godzilla.opcode == OPCODE_HALT) {
-                cpu->godzilla.enter_godzilla = FALSE;
+            case OPCODE_CML:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value - cpu->execute.intFU.imm;
+
+                break;
             }
 
-            if (cpu->godzilla.opcode == OPCODE_LOAD || 
-                cpu->godzilla.opcode == OPCODE_STORE || 
-                cpu->godzilla.opcode == OPCODE_LOADP || 
-                cpu->godzilla.opcode == OPCODE_STOREP) {
-                setup_entry_in_lsq(cpu);
+            case OPCODE_BZ:
+            case OPCODE_BNZ:
+            case OPCODE_BP:
+            case OPCODE_BNP:
+            case OPCODE_BN:
+            case OPCODE_BNN:
+            {
+                resolve_conditional_branch(cpu, cpu->execute.intFU.opcode, cpu->execute.intFU.pc,
+                                           cpu->execute.intFU.imm, cpu->execute.intFU.cc_value);
+
+                break;
             }
-            else {
-                cpu->godzilla.lsq_index = -1;
+
+            case OPCODE_JUMP:
+            {
+                resolve_indirect_jump(cpu, cpu->execute.intFU.ps1_value + cpu->execute.intFU.imm);
+                cpu->thread->cpu_rob[cpu->execute.intFU.rob_index].completed = TRUE;
+
+                break;
             }
 
-            setup_entry_in_rob(cpu);
+            case OPCODE_JALR:
+            {
+                resolve_indirect_jump(cpu, cpu->execute.intFU.ps1_value + cpu->execute.intFU.imm);
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.pc + 4;
 
-            setup_entry_in_iq(cpu);
-        }
+                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
+                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
 
-        // // printf("\nInstruction woken is: iq[%d]\n", cpu->godzilla.intfu_ready_insn);
-        // printf("\nINTFU: Instruction ready to go: %d\n", cpu->godzilla.intfu_ready_insn);
-        // printf("\nMULFU: Instruction ready to go: %d\n", cpu->godzilla.mulfu_ready_insn);
+                break;
+            }
 
-        wakeup_instructions(cpu, cpu->intFU_broadcasted_tag);
+            case OPCODE_AND:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value & cpu->execute.intFU.ps2_value;
 
-        if (cpu->execute.addFU.opcode == OPCODE_LOADP || cpu->execute.addFU.opcode == OPCODE_STOREP) {
-            printf("\nWaking after loadp/storep: %d\n", cpu->execute.addFU.lpsp_inc_dest);
-            wakeup_instructions(cpu, cpu->execute.addFU.lpsp_inc_dest);
-        }
-        // wakeup_instructions(cpu, cpu->addFU_broadcasted_tag);
+                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
+                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
 
-        if (cpu->godzilla.intfu_ready_insn != -1) {
-            if (cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].function_type == OPCODE_HALT) {
-                cpu->execute.intFU.has_insn = TRUE;
-                cpu->execute.intFU.pd = -1;
-                cpu->execute.intFU.ps1 = -1;
-                cpu->execute.intFU.ps2 = -1;
+                break;
             }
-            else {
-                cpu->execute.intFU.has_insn = TRUE;
-
-                cpu->execute.intFU.pd = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].dest;
-                
-                if (cpu->intFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag) {
-                    cpu->execute.intFU.ps1_value = cpu->intFU_broadcasted_value;
-                    cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_valid = 1;
-                    cpu->execute.intFU.ps1 = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag;
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag] = 0;
-                }
-                else if (cpu->mulFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag) {
-                    cpu->execute.intFU.ps1_value = cpu->mulFU_broadcasted_value;
-                    cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_valid = 1;
-                    cpu->execute.intFU.ps1 = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag;
-                    cpu->execute.intFU.forwarded_from_mul = 1;
+            case OPCODE_MOVC:
+            {
+                cpu->execute.intFU.result_buffer = cpu->execute.intFU.imm + 0;
 
-                    // printf("\nMUL forwarded to INT: pd[%d], ps1[%d]:%d, ps2[%d]:%d\n", cpu->execute.intFU.pd, cpu->execute.intFU.ps1, cpu->execute.intFU.ps1_value, cpu->execute.intFU.ps2, cpu->execute.intFU.ps2_value);
+                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
+                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag] = 0;
-                }
-                else {
-                    cpu->execute.intFU.ps1_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag].value;
-                    cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_valid = 1;
+                break;
+            }
+        }
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag] = 0;
-                }
+        /* A branch fused behind a CMP/CML resolves on the flags computed here */
+        if (is_conditional_branch(cpu->execute.intFU.fused_opcode)) {
+            resolve_conditional_branch(cpu, cpu->execute.intFU.fused_opcode, cpu->execute.intFU.pc + 4,
+                                       cpu->execute.intFU.fused_imm, result_flags(cpu->execute.intFU.result_buffer));
+        }
 
-                if (cpu->intFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag) {
-                    cpu->execute.intFU.ps2_value = cpu->intFU_broadcasted_value;
-                    cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_valid = 1;
-                    cpu->execute.intFU.ps2 = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag;
+        if (cpu->execute.intFU.cc_tag != -1) {
+            write_flags(cpu, cpu->execute.intFU.cc_tag, cpu->execute.intFU.result_buffer);
+        }
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag] = 0;
-                }
-                else if (cpu->mulFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag) {
-                    cpu->execute.intFU.ps2_value = cpu->mulFU_broadcasted_value;
-                    cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_valid = 1;
-                    cpu->execute.intFU.ps2 = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag;
-                    cpu->execute.intFU.forwarded_from_mul = 2;
+        cpu->execute.intFU.has_insn = FALSE;
+        trace_stage(cpu, cpu->execute.intFU.seq, PIPEVIEW_COMPLETE);
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag] = 0;
-                }
-                else {
-                    cpu->execute.intFU.ps2_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag].value;
-                    cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_valid = 1;
-                    cpu->execute.intFU.ps2 = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag;
+        broadcast_tag(cpu, cpu->intFU_broadcasted_tag);
+    }
+}
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag] = 0;
-                }
-                
-                // if (cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag &&
-                //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag &&
-                //     cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag &&
-                //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag) {
-                //     cpu->execute.intFU.ps1 = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag;
-                //     cpu->execute.intFU.ps2 = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag;
-                //     cpu->execute.intFU.ps1_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag].value;
-                //     cpu->execute.intFU.ps2_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag].value;
+/*
+This function is used to implement the Multiplication FU of the execute stage
+*/
+void run_mulFU (APEX_CPU *cpu) {
+    if (cpu->execute.mulFU.has_insn) {
+        if (cpu->execute.mulFU.forwarded_from_mul == 1) {
+            cpu->execute.mulFU.ps1_value = cpu->mulFU_broadcasted_value;
+            cpu->execute.mulFU.forwarded_from_mul = 0;
 
-                //     cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag] = 0;
-                //     cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps2_tag] = 0;
-                // }
+            // printf("\nEXEC - MUL forwarded value: %d\n", cpu->execute.mulFU.ps1_value);
+        }
+        else if (cpu->execute.mulFU.forwarded_from_mul == 2) {
+            cpu->execute.mulFU.ps2_value = cpu->mulFU_broadcasted_value;
+            cpu->execute.mulFU.forwarded_from_mul = 0;
 
-                cpu->execute.intFU.imm = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].literal;
-                cpu->execute.intFU.opcode = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].function_type;
+            // printf("\nEXEC - MUL forwarded value: %d\n", cpu->execute.mulFU.ps2_value);
+        }
 
-                // printf("\npd[%d] = ps1[%d], ps2[%d], imm[%d]\n", cpu->execute.intFU.pd, cpu->execute.intFU.ps1, cpu->execute.intFU.ps2, cpu->execute.intFU.imm);
+        if (cpu->execute.mulFU_clock == 0) {
+            cpu->execute.mulFU.result_buffer = cpu->execute.mulFU.ps1_value * cpu->execute.mulFU.ps2_value;
+            // printf("\nMUL => %d = %d X %d\n", cpu->execute.mulFU.result_buffer, cpu->execute.mulFU.ps1_value, cpu->execute.mulFU.ps2_value);
 
-                cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].isValid = FALSE;
-                cpu->godzilla.intfu_ready_insn = -1;
+            if (!timing_wheel_schedule(&cpu->timing_wheel, cpu->clock, MUL_FU_LATENCY - 1, EVENT_MUL_DONE)) {
+                cpu->halt_cpu = TRUE;
+                return;
             }
-            // // printf("\nexecute: pd: %d, ps1: %d, ps2: %d\n", cpu->execute.intFU.pd, cpu->execute.intFU.ps1, cpu->execute.intFU.ps2);
         }
 
-        if (cpu->godzilla.addfu_ready_insn != -1) {
-            cpu->execute.addFU.has_insn = TRUE;
+        if (timing_wheel_take(&cpu->timing_wheel, EVENT_MUL_DONE)) {
+            cpu->mulFU_broadcasted_tag = cpu->execute.mulFU.pd;
+            cpu->mulFU_broadcasted_value = cpu->execute.mulFU.result_buffer;
 
-            cpu->execute.addFU.pd = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].dest;
-            cpu->execute.addFU.lpsp_inc_dest = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].lpsp_inc_dest;
-            
-            if (cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].function_type == OPCODE_LOAD || cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].function_type == OPCODE_LOADP) {
-                if (cpu->intFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag) {
-                    cpu->execute.addFU.ps1_value = cpu->intFU_broadcasted_value;
-                    cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_valid = 1;
-                    cpu->execute.addFU.ps1 = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag;
+            // printf("\nMulFU fowarded value: %d\n", cpu->mulFU_broadcasted_value);
+            cpu->execute.mulFU.has_insn = FALSE;
+            trace_stage(cpu, cpu->execute.mulFU.seq, PIPEVIEW_COMPLETE);
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag] = 0;
-                }
-                else if (cpu->mulFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag) {
-                    cpu->execute.addFU.ps1_value = cpu->mulFU_broadcasted_value;
-                    cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_valid = 1;
-                    cpu->execute.addFU.ps1 = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag;
-                    cpu->execute.addFU.forwarded_from_mul = 1;
+            cpu->mulFU_broadcasted_tag = cpu->execute.mulFU.pd;
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag] = 0;
-                }
-                else {
-                    cpu->execute.addFU.ps1 = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag;
-                    cpu->execute.addFU.ps1_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag].value;
+            broadcast_tag(cpu, cpu->mulFU_broadcasted_tag);
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps1_tag] = 0;
-                }
+            if (cpu->execute.mulFU.cc_tag != -1) {
+                write_flags(cpu, cpu->execute.mulFU.cc_tag, cpu->execute.mulFU.result_buffer);
             }
-            else {
-                if (cpu->intFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag) {
-                    cpu->execute.addFU.ps2_value = cpu->intFU_broadcasted_value;
-                    cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_valid = 1;
-                    cpu->execute.addFU.ps2 = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag;
-
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag] = 0;
-                }
-                else if (cpu->mulFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag) {
-                    cpu->execute.addFU.ps2_value = cpu->mulFU_broadcasted_value;
-                    cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_valid = 1;
-                    cpu->execute.addFU.ps2 = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag;
-                    cpu->execute.addFU.forwarded_from_mul = 1;
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag] = 0;
-                }
-                else {
-                    cpu->execute.addFU.ps2 = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag;
-                    cpu->execute.addFU.ps2_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag].value;
+            cpu->execute.mulFU_clock = 0;
+        }
+        else {
+            cpu->execute.mulFU_clock++;
+        }
+    }
+}
 
-                    cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].ps2_tag] = 0;
-                }
-            }
+/*
+This method returns the cycles the divider takes for the operands
+*/
+static int div_latency (int dividend, int divisor) {
+#if DIV_FU_EARLY_OUT
+    unsigned int quotient;
+    int bits;
+    int latency;
+
+    if (divisor == 0) {
+        return 1;
+    }
 
-            // if (cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag &&
-            //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag) {
-            //     cpu->execute.intFU.ps1 = cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag;
-            //     cpu->execute.intFU.ps1_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag].value;
+    quotient = divisor == -1 ? (unsigned int)dividend : (unsigned int)(dividend / divisor);
+    if ((int)quotient < 0) {
+        quotient = -quotient;
+    }
+    bits = quotient ? 32 - __builtin_clz(quotient) : 0;
+    latency = 1 + (bits + DIV_FU_BITS_PER_CYCLE - 1) / DIV_FU_BITS_PER_CYCLE;
 
-            //     cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].ps1_tag] = 0;
-            // }
+    return latency < DIV_FU_LATENCY ? latency : DIV_FU_LATENCY;
+#else
+    (void)dividend;
+    (void)divisor;
 
-            cpu->execute.addFU.imm = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].literal;
-            cpu->execute.addFU.opcode = cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].function_type;
+    return DIV_FU_LATENCY;
+#endif
+}
 
-            cpu->cpu_iq[cpu->godzilla.addfu_ready_insn].isValid = FALSE;
-            cpu->godzilla.addfu_ready_insn = -1;
+/*
+This function is used to implement the Division FU of the execute stage. The result is written to the
+PRF and its tag broadcast in the cycle the divide completes. A zero divisor is recorded in the ROB entry
+and raised when the DIV reaches the ROB head.
+*/
+void run_divFU (APEX_CPU *cpu) {
+    if (cpu->execute.divFU.has_insn) {
+        if (cpu->execute.divFU_clock == 0) {
+            int dividend = cpu->execute.divFU.ps1_value;
+            int divisor = cpu->execute.divFU.ps2_value;
+
+            if (divisor == 0) {
+                cpu->thread->cpu_rob[cpu->execute.divFU.rob_index].mem_error_codes = MEM_ERROR_DIV_BY_ZERO;
+                cpu->execute.divFU.result_buffer = 0;
+            }
+            else if (divisor == -1) {
+                /* INT_MIN / -1 wraps instead of trapping on the host */
+                cpu->execute.divFU.result_buffer = (int)(0u - (unsigned int)dividend);
+            }
+            else {
+                cpu->execute.divFU.result_buffer = dividend / divisor;
+            }
 
-            // // printf("\nexecute: pd: %d, ps1: %d\n", cpu->execute.addFU.pd, cpu->execute.addFU.ps1);
+            if (!timing_wheel_schedule(&cpu->timing_wheel, cpu->clock, div_latency(dividend, divisor) - 1, EVENT_DIV_DONE)) {
+                cpu->halt_cpu = TRUE;
+                return;
+            }
         }
 
-        if (cpu->godzilla.mulfu_ready_insn != -1) {
-            cpu->execute.mulFU.has_insn = TRUE;
-
-            cpu->execute.mulFU.pd = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].dest;
-            
-            if (cpu->mulFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag) {
-                cpu->execute.mulFU.ps1_value = cpu->mulFU_broadcasted_value;
-                cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_valid = 1;
-                cpu->execute.mulFU.ps1 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag;
-                cpu->execute.mulFU.forwarded_from_mul = 1;
+        if (timing_wheel_take(&cpu->timing_wheel, EVENT_DIV_DONE)) {
+            cpu->execute.divFU.has_insn = FALSE;
+            trace_stage(cpu, cpu->execute.divFU.seq, PIPEVIEW_COMPLETE);
 
-                cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag] = 0;
+            cpu->cpu_prf[cpu->execute.divFU.pd].value = cpu->execute.divFU.result_buffer;
+            cpu->cpu_prf[cpu->execute.divFU.pd].isValid = TRUE;
+            broadcast_tag(cpu, cpu->execute.divFU.pd);
 
-                // printf("\n1. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
+            if (cpu->execute.divFU.cc_tag != -1) {
+                write_flags(cpu, cpu->execute.divFU.cc_tag, cpu->execute.divFU.result_buffer);
             }
-            else if (cpu->intFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag) {
-                cpu->execute.mulFU.ps1_value = cpu->intFU_broadcasted_value;
-                cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_valid = 1;
-                cpu->execute.mulFU.ps1 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag;
 
-                cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag] = 0;
+            cpu->execute.divFU_clock = 0;
+        }
+        else {
+            cpu->execute.divFU_clock++;
+        }
+    }
+}
 
-                // printf("\n2. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
-            }
-            else {
-                cpu->execute.mulFU.ps1 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag;
-                cpu->execute.mulFU.ps1_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag].value;
-                cpu->execute.mulFU.ps1 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag;
+/*
+This function is used to implement the Address Calculation FU of the execute stage
+*/
+void run_addFU (APEX_CPU *cpu) {
+    if (cpu->execute.addFU.has_insn) {
+        if (cpu->execute.addFU.forwarded_from_mul == 1) {
+            cpu->execute.addFU.ps1_value = cpu->mulFU_broadcasted_value;
+            cpu->execute.addFU.forwarded_from_mul = 0;
 
-                cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag] = 0;
+            // printf("\nEXEC - MUL forwarded value: %d\n", cpu->execute.addFU.ps1_value);
+        }
+        else if (cpu->execute.addFU.forwarded_from_mul == 2) {
+            cpu->execute.addFU.ps2_value = cpu->mulFU_broadcasted_value;
+            cpu->execute.addFU.forwarded_from_mul = 0;
+        }
 
-                // printf("\n3. Mul insn being sent: pd[%d], ps1[%d]: %d, ps2[%d]: %d\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps1_value, cpu->execute.mulFU.ps2, cpu->execute.mulFU.ps2_value);
-            }
+        if (cpu->debug_messages) {
+            printf("\nOPCODE is : %d\n", cpu->execute.addFU.opcode);
+        }
 
-            if (cpu->mulFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag) {
-                cpu->execute.mulFU.ps2_value = cpu->mulFU_broadcasted_value;
-                cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_valid = 1;
-                cpu->execute.mulFU.ps2 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag;
-                cpu->execute.mulFU.forwarded_from_mul = 2;
+        if (cpu->execute.addFU.opcode == OPCODE_LOAD) {
+            cpu->execute.addFU.result_buffer = cpu->execute.addFU.ps1_value + cpu->execute.addFU.imm;
 
-                cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag] = 0;
+            cpu->addFU_broadcasted_value = cpu->execute.addFU.result_buffer;
+            cpu->addFU_broadcasted_tag = cpu->execute.addFU.pd;
+        }
+        else if (cpu->execute.addFU.opcode == OPCODE_STORE) {
+            cpu->execute.addFU.result_buffer = cpu->execute.addFU.ps2_value + cpu->execute.addFU.imm;
 
-                // printf("\n4. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
-            }
-            else if (cpu->intFU_broadcasted_tag == cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag) {
-                cpu->execute.mulFU.ps2_value = cpu->intFU_broadcasted_value;
-                cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_valid = 1;
-                cpu->execute.mulFU.ps2 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag;
+            cpu->addFU_broadcasted_value = cpu->execute.addFU.result_buffer;
+            cpu->addFU_broadcasted_tag = cpu->execute.addFU.pd;
+        }
+        else if (cpu->execute.addFU.opcode == OPCODE_LOADP) {
+            cpu->execute.addFU.result_buffer = cpu->execute.addFU.ps1_value + cpu->execute.addFU.imm;
 
-                cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag] = 0;
+            cpu->addFU_broadcasted_value = cpu->execute.addFU.result_buffer;
+            cpu->addFU_broadcasted_tag = cpu->execute.addFU.pd;
 
-                // printf("\n5. Mul insn being sent: pd[%d], ps1[%d]: %d, ps2[%d]: %d\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps1_value, cpu->execute.mulFU.ps2, cpu->execute.mulFU.ps2_value);            
-                }
-            else {
-                cpu->execute.mulFU.ps2 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag;
-                cpu->execute.mulFU.ps2_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag].value;
-                cpu->execute.mulFU.ps2 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag;
+            cpu->cpu_prf[cpu->execute.addFU.lpsp_inc_dest].value = cpu->execute.addFU.ps1_value + 4;
+            cpu->cpu_prf[cpu->execute.addFU.lpsp_inc_dest].isValid = TRUE;
 
-                cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag] = 0;
+            broadcast_tag(cpu, cpu->execute.addFU.lpsp_inc_dest);
+        }
+        else if (cpu->execute.addFU.opcode == OPCODE_STOREP) {
+            cpu->execute.addFU.result_buffer = cpu->execute.addFU.ps2_value + cpu->execute.addFU.imm;
 
-                // printf("\n6. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
-            }
+            cpu->addFU_broadcasted_value = cpu->execute.addFU.result_buffer;
+            cpu->addFU_broadcasted_tag = cpu->execute.addFU.pd;
 
-            // if (cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag &&
-            //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag &&
-            //     cpu->intFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag &&
-            //     cpu->mulFU_broadcasted_tag != cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag) {
-            //     cpu->execute.intFU.ps1 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag;
-            //     cpu->execute.intFU.ps2 = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag;
-            //     cpu->execute.intFU.ps1_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag].value;
-            //     cpu->execute.intFU.ps2_value = cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag].value;
+            cpu->cpu_prf[cpu->execute.addFU.lpsp_inc_dest].value = cpu->execute.addFU.ps2_value + 4;
+            cpu->cpu_prf[cpu->execute.addFU.lpsp_inc_dest].isValid = TRUE;
 
-            //     cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps1_tag] = 0;
-            //     cpu->cpu_prf[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag].iq_dependency_list[cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].ps2_tag] = 0;
+            broadcast_tag(cpu, cpu->execute.addFU.lpsp_inc_dest);
+        }
 
-            //     // printf("\n5. Mul insn being sent: pd[%d], ps1[%d], ps2[%d]\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
-            // }
+        cpu->addFU_broadcasted_thread = cpu->execute.addFU.thread;
 
-            cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].isValid = FALSE;
-            cpu->execute.mulFU.opcode = cpu->cpu_iq[cpu->godzilla.mulfu_ready_insn].function_type;
-            cpu->godzilla.mulfu_ready_insn = -1;
+#if PREFETCH_DEGREE > 0
+        cpu->stats.prefetches += stride_prefetcher_train(&cpu->prefetcher, &cpu->dcache, cpu->execute.addFU.pc,
+                                                         cpu->execute.addFU.result_buffer, cpu->clock);
+#endif
 
-            // // printf("\nexecute: pd: %d, ps1: %d, ps2: %d\n", cpu->execute.mulFU.pd, cpu->execute.mulFU.ps1, cpu->execute.mulFU.ps2);
+        /* A load completes when its data comes back from memory */
+        if (cpu->execute.addFU.opcode != OPCODE_LOAD && cpu->execute.addFU.opcode != OPCODE_LOADP) {
+            trace_stage(cpu, cpu->execute.addFU.seq, PIPEVIEW_COMPLETE);
         }
 
-        if (cpu->addFU_broadcasted_tag != -1) {
-            cpu->cpu_lsq[cpu->addFU_broadcasted_tag].memory = cpu->addFU_broadcasted_value;
-            cpu->cpu_lsq[cpu->addFU_broadcasted_tag].mem_valid = TRUE;
+        cpu->execute.addFU.has_insn = FALSE;
+    }
+}
 
-            cpu->addFU_broadcasted_tag = -1;
-        }
+/*
+This method implements the EXECUTE stage of the pipeline
+*/
+static void APEX_execute (APEX_CPU *cpu) {
+    if (cpu->execute.is_halt_insn) {
+        cpu->halt_cpu = TRUE;
+    }
 
-        // printf("\nBroadcasted tag is: %d[%d] -> value is: %d\n", cpu->intFU_broadcasted_tag, cpu->cpu_prf[cpu->intFU_broadcasted_tag].isValid, cpu->intFU_broadcasted_value);
-        if (cpu->intFU_broadcasted_tag != -1) {
-            cpu->cpu_prf[cpu->intFU_broadcasted_tag].isValid = TRUE;
-            cpu->cpu_prf[cpu->intFU_broadcasted_tag].value = cpu->intFU_broadcasted_value;
+    /* Every FU works on the thread of the instruction it holds */
+    cpu->thread = &cpu->threads[cpu->execute.mulFU.thread];
+    run_mulFU(cpu);
 
-            // // printf("\nUpdated prf: prf[%d[%d]] = %d\n", cpu->intFU_broadcasted_tag, cpu->cpu_prf[cpu->intFU_broadcasted_tag].isValid, cpu->cpu_prf[cpu->intFU_broadcasted_tag].value);
-        }
-        if (cpu->mulFU_broadcasted_tag != -1 && cpu->execute.mulFU_clock == 0) {
-            cpu->cpu_prf[cpu->mulFU_broadcasted_tag].isValid = TRUE;
-            cpu->cpu_prf[cpu->mulFU_broadcasted_tag].value = cpu->mulFU_broadcasted_value;
-        }
+    cpu->thread = &cpu->threads[cpu->execute.divFU.thread];
+    run_divFU(cpu);
 
-        if (cpu->cpu_rob[cpu->rob_head].insn_type == dest_load_store || cpu->cpu_rob[cpu->rob_head].insn_type == dest_loadp_storep) {
-            perform_load_store(cpu);
-        }
-        else if (cpu->cpu_rob[cpu->rob_head].insn_type == dest_halt) {
-            if (cpu->cpu_iq[cpu->godzilla.intfu_ready_insn].function_type == OPCODE_HALT) {
-                cpu->execute.is_halt_insn = TRUE;
-                cpu->godzilla.has_insn = FALSE;
-                return;
-            }
-        }
-        else {
-            // printf("\nChecking if rob head is ready to commit: %d == %d\n", cpu->cpu_rob[cpu->rob_head].pd, cpu->cpu_prf[cpu->cpu_rob[cpu->rob_head].pd].isValid);
-            if (cpu->cpu_prf[cpu->cpu_rob[cpu->rob_head].pd].isValid == TRUE) {
-                cpu->regs[cpu->cpu_rob[cpu->rob_head].rd] = cpu->cpu_prf[cpu->cpu_rob[cpu->rob_head].pd].value;
+    cpu->thread = &cpu->threads[cpu->execute.intFU.thread];
+    run_intFU(cpu);
 
-                // printf("\nPutting %d into reg\n", cpu->cpu_prf[cpu->cpu_rob[cpu->rob_head].pd].value);
+    cpu->thread = &cpu->threads[cpu->execute.addFU.thread];
+    run_addFU(cpu);
 
-                if (cpu->cpu_rob[cpu->rob_head].overwritten_pd != -1) {
-                    cpu->free_reg_list[cpu->free_reg_tail] = cpu->cpu_rob[cpu->rob_head].overwritten_pd;
-                    cpu->free_reg_tail = (cpu->free_reg_tail + 1) % PRF_SIZE;
-                }
+    if (cpu->debug_messages) {
+        print_execute(cpu);
+    }
+}
 
-                cpu->cpu_rob[cpu->rob_head].isValid = FALSE;
-                cpu->rob_head = (cpu->rob_head + 1) % ROB_SIZE;
+#pragma endregion - Execute Stage
 
-                // printf("\nReg updated is: %d: %d\n", cpu->cpu_rob[cpu->rob_head-1].rd, cpu->regs[cpu->cpu_rob[cpu->rob_head-1].rd]);
-            }
-            // else if (cpu->cpu_rob[cpu->rob_head].pd == cpu->intFU_broadcasted_tag) {
-            //     cpu->regs[cpu->cpu_rob[cpu->rob_head].rd] = cpu->intFU_broadcasted_value;
+/*
+This method loads the program of filename into a hardware thread and resets its state: it starts at
+the first instruction with its registers at zero, the reference model starts from the data memory as
+it is now
+*/
+static int
+thread_init(APEX_CPU *cpu, APEX_Thread *thread, const char *filename)
+{
+    thread->id = thread - cpu->threads;
+    thread->pc = 4000;
+    thread->insn_completed = 0;
+    thread->halt_cycle = -1;
+    thread->last_retired_pc = -1;
+    memset(thread->regs, 0, sizeof(int) * REG_FILE_SIZE);
 
-            //     if (cpu->cpu_rob[cpu->rob_head].overwritten_pd != -1) {
-            //         cpu->free_reg_list[cpu->free_reg_tail] = cpu->cpu_rob[cpu->rob_head].overwritten_pd;
-            //         cpu->free_reg_tail = (cpu->free_reg_tail + 1) % PRF_SIZE;
-            //     }
+    /* Parse input file and create code memory */
+    thread->code_memory = create_code_memory(filename, &thread->code_memory_size);
+    if (!thread->code_memory)
+    {
+        return FALSE;
+    }
 
-            //     cpu->cpu_rob[cpu->rob_head].isValid = FALSE;
-            //     cpu->rob_head = (cpu->rob_head + 1) % ROB_SIZE;
-            // }
-            // else if (cpu->cpu_rob[cpu->rob_head].pd == cpu->mulFU_broadcasted_tag) {
-            //     cpu->regs[cpu->cpu_rob[cpu->rob_head].rd] = cpu->mulFU_broadcasted_value;
+    if (!golden_model_init(&thread->golden, thread->code_memory, thread->code_memory_size))
+    {
+        free(thread->code_memory);
+        return FALSE;
+    }
 
-            //     if (cpu->cpu_rob[cpu->rob_head].overwritten_pd != -1) {
-            //         cpu->free_reg_list[cpu->free_reg_tail] = cpu->cpu_rob[cpu->rob_head].overwritten_pd;
-            //         cpu->free_reg_tail = (cpu->free_reg_tail + 1) % PRF_SIZE;
-            //     }
+    data_memory_free(&thread->golden.data_memory);
+    if (!data_memory_copy(&thread->golden.data_memory, &cpu->data_memory))
+    {
+        golden_model_free(&thread->golden);
+        free(thread->code_memory);
+        return FALSE;
+    }
 
-            //     cpu->cpu_rob[cpu->rob_head].isValid = FALSE;
-            //     cpu->rob_head = (cpu->rob_head + 1) % ROB_SIZE;
-            // }
-        }
+    thread->rob_head = 0;
+    thread->rob_tail = 0;
 
-        if (cpu->intFU_broadcasted_tag != -1) {
-            // printf("\nUpdated prf: prf[%d[%d]] = %d\n", cpu->intFU_broadcasted_tag, cpu->cpu_prf[cpu->intFU_broadcasted_tag].isValid, cpu->cpu_prf[cpu->intFU_broadcasted_tag].value);
-        }
+    thread->lsq_head = 0;
+    thread->lsq_tail = 0;
 
-        cpu->intFU_broadcasted_tag = -1;
-        cpu->mulFU_broadcasted_tag = -1;
-        cpu->addFU_broadcasted_tag = -1;
+    for (int i = 0; i < ROB_SIZE; i++) {
+        thread->cpu_rob[i].isValid = FALSE;
+    }
 
-        should_dispatch_stall(cpu);
+    for (int i = 0; i < LSQ_SIZE; i++) {
+        thread->cpu_lsq[i].isValid = FALSE;
+        thread->lsq_ps1_tag[i] = -1;
+    }
 
-        // printf("\nExecute.has_insn before broadcast: %d for pd[%d]\n", cpu->execute.intFU.has_insn, cpu->execute.intFU.pd);
-        // broadcast_tags(cpu);
+    for (int i = 0; i < REG_FILE_SIZE; i++) {
+        thread->rename_table[i] = -1;
+    }
 
-        if (ENABLE_DEBUG_MESSAGES) {
-            print_godzilla(cpu);
-        }
+    /* Every thread renames its flags onto its own CPRF_SIZE condition code registers */
+    for (int i = 0; i < CPRF_SIZE; i++) {
+        thread->cc_free_list[i] = thread->id * CPRF_SIZE + i;
     }
-}
 
-#pragma endregion - Godzilla Stage
+    thread->cc_free_head = 0;
+    thread->cc_free_tail = 0;
+    thread->cc_free_count = CPRF_SIZE;
+    thread->cc_free_allocs = 0;
+    thread->cc_rename = -1;
 
-#pragma region - Execute Stage 
+    for (int i = 0; i < CHECKPOINT_COUNT; i++) {
+        thread->checkpoints[i].isValid = FALSE;
+    }
 
-/*
-This function is used to implement the Integer FU of the execute stage
-*/
-void run_intFU (APEX_CPU *cpu) {
-    if (cpu->execute.intFU.has_insn) {
-        if (cpu->execute.intFU.forwarded_from_mul == 1) {
-            cpu->execute.intFU.ps1_value = cpu->mulFU_broadcasted_value;
-            cpu->execute.intFU.forwarded_from_mul = 0;
-            // printf("\nEXEC - MUL forwarded value: %d\n", cpu->execute.intFU.ps1_value);
-        }
-        else if (cpu->execute.intFU.forwarded_from_mul == 2) {
-            cpu->execute.intFU.ps2_value = cpu->mulFU_broadcasted_value;
-            cpu->execute.intFU.forwarded_from_mul = 0;
-        }
+    target_predictor_init(&thread->target_pred);
+    value_predictor_init(&thread->value_pred);
 
-        switch (cpu->execute.intFU.opcode) {
-            case OPCODE_ADD:
-            {
-                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value + cpu->execute.intFU.ps2_value;
+    thread->godzilla.has_insn = FALSE;
+    thread->godzilla.insn_pending = FALSE;
+    thread->godzilla.enter_godzilla = TRUE;
 
-                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
-                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
+    thread->fetch_buffer.has_insn = FALSE;
+    thread->decode_rename.has_insn = FALSE;
+    thread->rename_dispatch.has_insn = FALSE;
 
-                break;
-            }
+    /* To start fetch stage */
+    thread->fetch.has_insn = TRUE;
+    return TRUE;
+}
 
-            case OPCODE_ADDL:
-            {
-                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value + cpu->execute.intFU.imm;
+/*
+ * This function creates and initializes APEX cpu.
+ *
+ * Note: You are free to edit this function according to your implementation
+ */
+APEX_CPU *
+APEX_cpu_init(const char *filename)
+{
+    APEX_CPU *cpu;
 
-                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
-                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
+    if (!filename)
+    {
+        return NULL;
+    }
 
-                break;
-            }
+    cpu = calloc(1, sizeof(APEX_CPU));
 
-            case OPCODE_SUB:
-            {
-                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value - cpu->execute.intFU.ps2_value;
+    if (!cpu)
+    {
+        return NULL;
+    }
 
-                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
-                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
+    /* Initialize Registers and all pipeline stages */
+    cpu->single_step = ENABLE_SINGLE_STEP;
+    cpu->debug_messages = ENABLE_DEBUG_MESSAGES;
 
-                break;
-            }
+    if (!data_memory_init(&cpu->data_memory))
+    {
+        free(cpu);
+        return NULL;
+    }
 
-            case OPCODE_SUBL:
-            {
-                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value - cpu->execute.intFU.imm;
+    cpu->thread = &cpu->threads[0];
+    if (!thread_init(cpu, cpu->thread, filename))
+    {
+        data_memory_free(&cpu->data_memory);
+        free(cpu);
+        return NULL;
+    }
+    cpu->thread_count = 1;
+    cpu->fetch_policy = SMT_FETCH_ICOUNT;
+    cpu->queue_policy = SMT_QUEUES_SHARED;
+    cpu->fetch_thread = 0;
 
-                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
-                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
+    for (int i = 0; i < PRF_SIZE; i++)
+    {
+        cpu->cpu_prf[i].isValid = TRUE;
+        cpu->cpu_prf[i].value = -1;
+        cpu->cpu_prf[i].pending_retires = 0;
+    }
 
-                break;
-            }
-            
-            case OPCODE_OR:
-            {
-                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value | cpu->execute.intFU.ps2_value;
+    for (int i = 0; i < IQ_SIZE; i++) {
+        iq_release_entry(cpu, i);
+        cpu->iq_sched.ps1_tag[i] = -1;
+        cpu->iq_sched.ps2_tag[i] = -1;
+    }
 
-                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
-                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
+    cpu->prf_size = PRF_BASE_SIZE;
+    for (int i = 0; i < cpu->prf_size; i++) {
+        bitset_set(cpu->free_regs, i);
+    }
+    cpu->free_reg_count = cpu->prf_size;
 
-                break;
-            }
+    for (int i = 0; i < CPRF_SIZE * SMT_THREADS_MAX; i++) {
+        cpu->cpu_cprf[i].isValid = TRUE;
+        cpu->cpu_cprf[i].value = 0;
+    }
 
-            case OPCODE_XOR:
-            {
-                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value ^ cpu->execute.intFU.ps2_value;
+    data_cache_init(&cpu->dcache);
+    stride_prefetcher_init(&cpu->prefetcher);
 
-                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
-                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
+    cpu->execute.addFU.has_insn = FALSE;
+    cpu->execute.addFU.forwarded_from_mul = 0;
+    cpu->execute.intFU.has_insn = FALSE;
+    cpu->execute.intFU.forwarded_from_mul = 0;
+    cpu->execute.mulFU.has_insn = FALSE;
+    cpu->execute.mulFU.forwarded_from_mul = 0;
+    cpu->execute.mulFU_clock = 0;
+    cpu->execute.divFU.has_insn = FALSE;
+    cpu->execute.divFU_clock = 0;
+    cpu->execute.is_halt_insn = FALSE;
 
-                break;
-            }
+    cpu->intfu_ready_insn = -1;
+    cpu->addfu_ready_insn = -1;
+    cpu->mulfu_ready_insn = -1;
+    cpu->divfu_ready_insn = -1;
+    cpu->mem_stage_clock = 0;
+    cpu->mem_port_thread = NULL;
 
-            case OPCODE_CMP:
-            case OPCODE_CML:
-            {
-                break;
-            }
+    cpu->intFU_broadcasted_tag = -1;
+    cpu->mulFU_broadcasted_tag = -1;
+    cpu->addFU_broadcasted_tag = -1;
 
-            case OPCODE_AND:
-            {
-                cpu->execute.intFU.result_buffer = cpu->execute.intFU.ps1_value & cpu->execute.intFU.ps2_value;
+    cpu->halt_cpu = FALSE;
 
-                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
-                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
+    cpu->cosim_enabled = ENABLE_COSIM;
 
-                break;
-            }
+    timing_wheel_init(&cpu->timing_wheel);
+    cpu->skip_idle_cycles = ENABLE_IDLE_CYCLE_SKIP;
 
-            case OPCODE_MOVC:
-            {
-                cpu->execute.intFU.result_buffer = cpu->execute.intFU.imm + 0;
+    return cpu;
+}
 
-                cpu->intFU_broadcasted_value = cpu->execute.intFU.result_buffer;
-                cpu->intFU_broadcasted_tag = cpu->execute.intFU.pd;
+/*
+ * This function loads the program of filename into another hardware thread of the CPU, which runs it
+ * alongside the threads already loaded. Every thread brings REG_FILE_SIZE more physical registers to
+ * hold its architectural registers. It must be called before the first cycle; the functions setting a
+ * thread up, such as APEX_cpu_set_entry_pc, then apply to the new thread.
+ */
+int
+APEX_cpu_add_thread(APEX_CPU *cpu, const char *filename)
+{
+    if (cpu->thread_count == SMT_THREADS_MAX)
+    {
+        fprintf(stderr, "APEX_Error: A core runs at most %d threads\n", SMT_THREADS_MAX);
+        return FALSE;
+    }
 
-                break;
-            }
-        }
+    if (!thread_init(cpu, &cpu->threads[cpu->thread_count], filename))
+    {
+        return FALSE;
+    }
 
-        cpu->execute.intFU.has_insn = FALSE;
+    cpu->thread = &cpu->threads[cpu->thread_count++];
 
-        wakeup_instructions(cpu, cpu->intFU_broadcasted_tag);
+    for (int i = cpu->prf_size; i < cpu->prf_size + REG_FILE_SIZE; i++) {
+        bitset_set(cpu->free_regs, i);
     }
+    cpu->prf_size += REG_FILE_SIZE;
+    cpu->free_reg_count += REG_FILE_SIZE;
+
+    return TRUE;
 }
 
 /*
-This function is used to implement the Multiplication FU of the execute stage
+This method is used to print the contents of the stage after every clock cycle
 */
-void run_mulFU (APEX_CPU *cpu) {
-    if (cpu->execute.mulFU.has_insn) {
-        if (cpu->execute.mulFU.forwarded_from_mul == 1) {
-            cpu->execute.mulFU.ps1_value = cpu->mulFU_broadcasted_value;
-            cpu->execute.mulFU.forwarded_from_mul = 0;
+void print_cpu_status (APEX_CPU *cpu) {
+    print_stage_content("Fetch", &cpu->thread->fetch);
+    print_stage_content("Decode1", &cpu->thread->decode_rename);
+    print_stage_content("Decode2", &cpu->thread->rename_dispatch);
+    print_godzilla(cpu);
+    print_execute(cpu);
+}
 
-            // printf("\nEXEC - MUL forwarded value: %d\n", cpu->execute.mulFU.ps1_value);
-        }
-        else if (cpu->execute.mulFU.forwarded_from_mul == 2) {
-            cpu->execute.mulFU.ps2_value = cpu->mulFU_broadcasted_value;
-            cpu->execute.mulFU.forwarded_from_mul = 0;
+/*
+This method returns TRUE if neither the front end nor the commit of the thread can make progress in the
+current cycle. A front-end stage holding an instruction is idle while it is blocked behind the stage after
+it, which only the events can unblock.
+*/
+static int
+thread_is_idle(APEX_CPU *cpu, APEX_Thread *thread)
+{
+    const CPU_ROB *rob_head = &thread->cpu_rob[thread->rob_head];
+    int dispatch_blocked;
+    int decode_blocked;
+
+    /* Dispatch waits for room in the IQ, ROB and LSQ, decode for dispatch or for free registers and
+       checkpoints, fetch for room in decode or the fetch buffer or for a JUMP/JALR with no predicted
+       target to resolve */
+    cpu->thread = thread;
+    dispatch_blocked = !thread->rename_dispatch.has_insn || !thread->godzilla.enter_godzilla;
+    decode_blocked = !thread->decode_rename.has_insn ||
+                     (thread->rename_dispatch.has_insn && dispatch_blocked) ||
+                     rename_needs_stall(cpu, &thread->decode_rename);
+
+    if (thread->godzilla.insn_pending || !dispatch_blocked || !decode_blocked ||
+        (!thread->decode_rename.has_insn && thread->fetch_buffer.has_insn)) {
+        return FALSE;
+    }
+
+    if (thread->fetch.has_insn && !thread->branch_in_flight &&
+        !(thread->decode_rename.has_insn && thread->fetch_buffer.has_insn)) {
+        return FALSE;
+    }
+
+    if (thread->halt_cycle != -1) {
+        return TRUE;
+    }
+
+    /* Commit */
+    if (!rob_head->isValid || rob_head->insn_type == dest_halt || rob_head->insn_type == dest_none) {
+        return FALSE;
+    }
 
-            // printf("\nEXEC - MUL forwarded value: %d\n", cpu->execute.mulFU.ps2_value);
-        }
+    if (rob_head->insn_type == dest_load_store || rob_head->insn_type == dest_loadp_storep) {
+        const CPU_LSQ *lsq_head = &thread->cpu_lsq[thread->lsq_head];
 
-        if (cpu->execute.mulFU_clock == 0) {
-            cpu->execute.mulFU.result_buffer = cpu->execute.mulFU.ps1_value * cpu->execute.mulFU.ps2_value;
-            // printf("\nMUL => %d = %d X %d\n", cpu->execute.mulFU.result_buffer, cpu->execute.mulFU.ps1_value, cpu->execute.mulFU.ps2_value);
+        if (cpu->mem_stage_clock == 0 && lsq_head->mem_valid &&
+            (lsq_head->lORs == 1 || cpu->cpu_prf[lsq_head->ps1_tag].isValid)) {
+            return FALSE;
         }
-        else if (cpu->execute.mulFU_clock == 1) {
-            // cpu->mulFU_broadcasted_tag = cpu->execute.mulFU.pd;
+    }
+    else if (rob_entry_done(cpu, rob_head)) {
+        return FALSE;
+    }
 
-            // wakeup_instructions(cpu, cpu->mulFU_broadcasted_tag);
-        }
-        else if (cpu->execute.mulFU_clock == 2) {
-            cpu->mulFU_broadcasted_tag = cpu->execute.mulFU.pd;
-            cpu->mulFU_broadcasted_value = cpu->execute.mulFU.result_buffer;
+    return TRUE;
+}
 
-            // printf("\nMulFU fowarded value: %d\n", cpu->mulFU_broadcasted_value);
-            cpu->execute.mulFU.has_insn = FALSE;
+/*
+This method returns TRUE if no stage can make progress in the current cycle other than by waiting
+on an event scheduled on the timing wheel. It follows the conditions under which each stage changes
+state and answers FALSE whenever it is unsure.
+*/
+static int
+pipeline_is_idle(APEX_CPU *cpu)
+{
+    if (cpu->timing_wheel.fired || cpu->halt_cpu || cpu->execute.is_halt_insn) {
+        return FALSE;
+    }
 
-            cpu->mulFU_broadcasted_tag = cpu->execute.mulFU.pd;
+    /* Execute stage and result buses */
+    if (cpu->execute.intFU.has_insn || cpu->execute.addFU.has_insn ||
+        (cpu->execute.mulFU.has_insn && cpu->execute.mulFU_clock == 0) ||
+        (cpu->execute.divFU.has_insn && cpu->execute.divFU_clock == 0)) {
+        return FALSE;
+    }
 
-            wakeup_instructions(cpu, cpu->mulFU_broadcasted_tag);
-        }
+    if (cpu->intFU_broadcasted_tag != -1 || cpu->mulFU_broadcasted_tag != -1 || cpu->addFU_broadcasted_tag != -1) {
+        return FALSE;
+    }
+
+    if (cpu->intfu_ready_insn != -1 || cpu->addfu_ready_insn != -1 || cpu->mulfu_ready_insn != -1 ||
+        cpu->divfu_ready_insn != -1) {
+        return FALSE;
+    }
+
+    /* Issue queue: nothing to wake up and nothing ready for a free FU */
+    if (cpu->wakeup_tag_count > 0) {
+        return FALSE;
+    }
+
+    if ((!cpu->execute.intFU.has_insn && iq_select_oldest(cpu, INT_FU) != -1) ||
+        (!cpu->execute.addFU.has_insn && iq_select_oldest(cpu, ADD_FU) != -1) ||
+        (!cpu->execute.mulFU.has_insn && iq_select_oldest(cpu, MUL_FU) != -1) ||
+        (!cpu->execute.divFU.has_insn && iq_select_oldest(cpu, DIV_FU) != -1)) {
+        return FALSE;
+    }
 
-        cpu->execute.mulFU_clock = (cpu->execute.mulFU_clock + 1)%3;
+    for (int t = 0; t < cpu->thread_count; t++) {
+        if (!thread_is_idle(cpu, &cpu->threads[t])) {
+            return FALSE;
+        }
     }
+
+    return TRUE;
 }
 
 /*
-This function is used to implement the Address Calculation FU of the execute stage
+This method accounts the per-cycle counters for the given number of cycles spent in the current state
 */
-void run_addFU (APEX_CPU *cpu) {
+static void
+account_cycles(APEX_CPU *cpu, int cycles)
+{
+    if (cpu->execute.intFU.has_insn) {
+        cpu->stats.intFU_busy_cycles += cycles;
+    }
+
     if (cpu->execute.addFU.has_insn) {
-        if (cpu->execute.addFU.forwarded_from_mul == 1) {
-            cpu->execute.addFU.ps1_value = cpu->mulFU_broadcasted_value;
-            cpu->execute.addFU.forwarded_from_mul = 0;
+        cpu->stats.addFU_busy_cycles += cycles;
+    }
 
-            // printf("\nEXEC - MUL forwarded value: %d\n", cpu->execute.addFU.ps1_value);
-        }
+    if (cpu->execute.mulFU.has_insn) {
+        cpu->stats.mulFU_busy_cycles += cycles;
+    }
 
-        printf("\nOPCODE is : %d\n", cpu->execute.addFU.opcode);
+    if (cpu->execute.divFU.has_insn) {
+        cpu->stats.divFU_busy_cycles += cycles;
+    }
 
-        if (cpu->execute.addFU.opcode == OPCODE_LOADP) {
-            cpu->execute.addFU.result_buffer = cpu->execute.addFU.ps1_value + cpu->execute.addFU.imm;
+    if (cpu->mem_stage_clock > 0) {
+        cpu->stats.mem_busy_cycles += cycles;
+    }
 
-            cpu->addFU_broadcasted_value = cpu->execute.addFU.result_buffer;
-            cpu->addFU_broadcasted_tag = cpu->execute.addFU.pd;
+    /* The stalls of the front end are counted for every thread */
+    for (int t = 0; t < cpu->thread_count; t++) {
+        cpu->thread = &cpu->threads[t];
 
-            cpu->cpu_prf[cpu->execute.addFU.lpsp_inc_dest].value = cpu->execute.addFU.ps1_value + 4;
-            cpu->cpu_prf[cpu->execute.addFU.lpsp_inc_dest].isValid = TRUE;
+        if (cpu->thread->rename_dispatch.has_insn && !cpu->thread->godzilla.enter_godzilla) {
+            cpu->stats.dispatch_stall_cycles += cycles;
 
-            // wakeup_instructions(cpu, cpu->execute.addFU.lpsp_inc_dest);
+            switch (cpu->thread->godzilla.stall_cause) {
+                case STALL_IQ_FULL:
+                    cpu->stats.iq_full_stall_cycles += cycles;
+                    break;
 
-            cpu->godzilla.mem_insn_reg_updt.dest = cpu->cpu_lsq[cpu->execute.addFU.pd].dest;
-            cpu->godzilla.mem_insn_reg_updt.incr_dest = cpu->execute.addFU.lpsp_inc_dest;
+                case STALL_ROB_FULL:
+                    cpu->stats.rob_full_stall_cycles += cycles;
+                    break;
 
-            printf("\nInit - LOADP: Committing %d -> %d\n", cpu->godzilla.mem_insn_reg_updt.dest, cpu->godzilla.mem_insn_reg_updt.incr_dest);
+                case STALL_LSQ_FULL:
+                    cpu->stats.lsq_full_stall_cycles += cycles;
+                    break;
+            }
+        }
+        else if (cpu->thread->decode_rename.has_insn && !cpu->thread->rename_dispatch.has_insn &&
+                 rename_needs_stall(cpu, &cpu->thread->decode_rename)) {
+            cpu->stats.free_list_stall_cycles += cycles;
         }
-        else if (cpu->execute.addFU.opcode == OPCODE_STOREP) {
-            cpu->execute.addFU.result_buffer = cpu->execute.addFU.ps2_value + cpu->execute.addFU.imm;
 
-            cpu->addFU_broadcasted_value = cpu->execute.addFU.result_buffer;
-            cpu->addFU_broadcasted_tag = cpu->execute.addFU.pd;
+        if (cpu->thread->branch_in_flight) {
+            cpu->stats.branch_stall_cycles += cycles;
+        }
+    }
+}
 
-            cpu->cpu_prf[cpu->execute.addFU.lpsp_inc_dest].value = cpu->execute.addFU.ps2_value + 4;
-            cpu->cpu_prf[cpu->execute.addFU.lpsp_inc_dest].isValid = TRUE;
+/*
+This method jumps the clock to the next scheduled event when the pipeline is idle until then.
+The skipped cycles are accounted in bulk and the in-flight unit clocks are advanced as if they had ticked.
+*/
+static void
+skip_idle_cycles(APEX_CPU *cpu)
+{
+    int next_due;
+    int skipped;
 
-            // wakeup_instructions(cpu, cpu->execute.addFU.lpsp_inc_dest);
+    if (!pipeline_is_idle(cpu)) {
+        return;
+    }
 
-            cpu->godzilla.mem_insn_reg_updt.dest = cpu->cpu_lsq[cpu->execute.addFU.pd].dest;
-            cpu->godzilla.mem_insn_reg_updt.incr_dest = cpu->execute.addFU.lpsp_inc_dest;
+    next_due = timing_wheel_next_due(&cpu->timing_wheel, cpu->clock);
+    if (next_due == -1) {
+        return;
+    }
 
-            printf("\nInit - STOREP: Committing %d -> %d\n", cpu->godzilla.mem_insn_reg_updt.dest, cpu->godzilla.mem_insn_reg_updt.incr_dest);
-        }
+    skipped = next_due - cpu->clock;
 
-        cpu->execute.addFU.has_insn = FALSE;
+    account_cycles(cpu, skipped);
 
-        // wakeup_instructions(cpu, cpu->addFU_broadcasted_tag);
+    if (cpu->execute.mulFU.has_insn) {
+        cpu->execute.mulFU_clock += skipped;
     }
-}
 
-/*
-This method implements the EXECUTE stage of the pipeline
-*/
-static void APEX_execute (APEX_CPU *cpu) {
-    if (cpu->execute.is_halt_insn) {
-        cpu->halt_cpu = TRUE;
+    if (cpu->execute.divFU.has_insn) {
+        cpu->execute.divFU_clock += skipped;
     }
 
-    run_mulFU(cpu);
+    if (cpu->mem_stage_clock > 0) {
+        cpu->mem_stage_clock += skipped;
+    }
 
-    run_intFU(cpu);
+    cpu->stats.cycles_skipped += skipped;
+    cpu->clock = next_due;
 
-    run_addFU(cpu);
+    timing_wheel_advance(&cpu->timing_wheel, cpu->clock);
 
-    if (ENABLE_DEBUG_MESSAGES) {
-        print_execute(cpu);
+    if (cpu->debug_messages) {
+        printf("Skipped %d idle cycles\n", skipped);
     }
 }
 
-#pragma endregion - Execute Stage
-
+#if ENABLE_HOST_PROFILING
 /*
- * This function creates and initializes APEX cpu.
- *
- * Note: You are free to edit this function according to your implementation
- */
-APEX_CPU *
-APEX_cpu_init(const char *filename)
-{
-    int i;
-    APEX_CPU *cpu;
+This method prints the host time charged to every simulator stage over the run
+*/
+void print_host_profile (const APEX_CPU *cpu) {
+    static const char *stage_names[PROF_STAGES] = {
+        "fetch", "decode", "dispatch", "godzilla allocate", "godzilla wakeup",
+        "godzilla issue", "godzilla commit", "godzilla LSQ", "execute", "other"
+    };
+    uint64_t total = 0;
+
+    for (int i = 0; i < PROF_STAGES; i++) {
+        total += cpu->host_profile.ticks[i];
+    }
 
-    if (!filename)
-    {
-        return NULL;
+    printf("----------\n%s\n----------\n", "Host profile:");
+    for (int i = 0; i < PROF_STAGES; i++) {
+        printf("%-18s %14llu ticks  %5.1f%%  %8.1f ticks/cycle\n", stage_names[i],
+               (unsigned long long)cpu->host_profile.ticks[i],
+               total ? 100.0 * cpu->host_profile.ticks[i] / total : 0.0,
+               cpu->clock ? (double)cpu->host_profile.ticks[i] / cpu->clock : 0.0);
     }
+    printf("\n");
+}
+#endif
 
-    cpu = calloc(1, sizeof(APEX_CPU));
+/*
+This method is used to print the run counters at the end of the simulation
+*/
+void print_stats (const APEX_CPU *cpu) {
+    printf("----------\n%s\n----------\n", "Stats:");
+    printf("cycles = %d, instructions = %d\n", cpu->clock, cpu->insn_completed);
+    printf("idle cycles skipped = %lld\n", cpu->stats.cycles_skipped);
+    printf("INT FU busy cycles = %lld\n", cpu->stats.intFU_busy_cycles);
+    printf("address FU busy cycles = %lld\n", cpu->stats.addFU_busy_cycles);
+    printf("MUL FU busy cycles = %lld\n", cpu->stats.mulFU_busy_cycles);
+    printf("DIV FU busy cycles = %lld\n", cpu->stats.divFU_busy_cycles);
+    printf("memory busy cycles = %lld\n", cpu->stats.mem_busy_cycles);
+    printf("dispatch stall cycles = %lld (IQ full %lld, ROB full %lld, LSQ full %lld)\n",
+           cpu->stats.dispatch_stall_cycles, cpu->stats.iq_full_stall_cycles,
+           cpu->stats.rob_full_stall_cycles, cpu->stats.lsq_full_stall_cycles);
+    printf("free list stall cycles = %lld\n", cpu->stats.free_list_stall_cycles);
+    printf("branches = %lld (taken %lld), fetch stalled on branches %lld cycles\n",
+           cpu->stats.branches, cpu->stats.branches_taken, cpu->stats.branch_stall_cycles);
+    printf("branch mispredictions = %lld, instructions squashed = %lld\n",
+           cpu->stats.branch_mispredicts, cpu->stats.insns_squashed);
+    printf("physical registers released early = %lld\n", cpu->stats.regs_released_early);
+    printf("moves eliminated = %lld, constants materialized at rename = %lld\n",
+           cpu->stats.moves_eliminated, cpu->stats.consts_materialized);
+    printf("fused pairs = %lld (%.1f%% of instructions retired fused)\n", cpu->stats.fused_pairs,
+           cpu->insn_completed ? 200.0 * cpu->stats.fused_pairs / cpu->insn_completed : 0.0);
+    printf("loop buffer replays = %lld (%.1f%% of instructions fetched)\n", cpu->stats.loop_buffer_insns,
+           cpu->fetch_seq ? 100.0 * cpu->stats.loop_buffer_insns / cpu->fetch_seq : 0.0);
+    printf("load values predicted = %lld (mispredicted %lld)\n", cpu->stats.value_predictions,
+           cpu->stats.value_mispredicts);
+    printf("data cache accesses = %lld (misses %lld)\n", cpu->stats.dcache_accesses, cpu->stats.dcache_misses);
+    printf("prefetches = %lld (useful %lld, late %lld): accuracy %.1f%%, coverage %.1f%%, timely %.1f%%\n",
+           cpu->stats.prefetches, cpu->stats.prefetches_useful, cpu->stats.prefetches_late,
+           cpu->stats.prefetches ? 100.0 * cpu->stats.prefetches_useful / cpu->stats.prefetches : 0.0,
+           cpu->stats.prefetches_useful + cpu->stats.dcache_misses ?
+               100.0 * cpu->stats.prefetches_useful / (cpu->stats.prefetches_useful + cpu->stats.dcache_misses) : 0.0,
+           cpu->stats.prefetches_useful ?
+               100.0 * (cpu->stats.prefetches_useful - cpu->stats.prefetches_late) / cpu->stats.prefetches_useful : 0.0);
+    printf("RAS predictions = %lld (correct %lld), indirect-target predictions = %lld (correct %lld), unpredicted = %lld\n",
+           cpu->stats.ras_predictions, cpu->stats.ras_correct, cpu->stats.itt_predictions,
+           cpu->stats.itt_correct, cpu->stats.indirect_unpredicted);
+    printf("\n");
+}
 
-    if (!cpu)
-    {
-        return NULL;
+/*
+This method snapshots the run counters and the queue occupancies for the interval sampler
+*/
+static void take_sample (APEX_CPU *cpu, int cycle) {
+    Stat_Sample sample;
+
+    sample.cycle = cycle;
+    sample.insn_completed = cpu->insn_completed;
+    sample.iq_occupancy = bitset_count(cpu->iq_sched.valid, IQ_WORDS);
+    sample.rob_occupancy = 0;
+    sample.lsq_occupancy = 0;
+    for (int t = 0; t < cpu->thread_count; t++) {
+        sample.rob_occupancy += thread_rob_occupancy(&cpu->threads[t]);
+        sample.lsq_occupancy += thread_lsq_occupancy(&cpu->threads[t]);
     }
+    sample.iq_full_stall_cycles = cpu->stats.iq_full_stall_cycles;
+    sample.rob_full_stall_cycles = cpu->stats.rob_full_stall_cycles;
+    sample.lsq_full_stall_cycles = cpu->stats.lsq_full_stall_cycles;
+    sample.free_list_stall_cycles = cpu->stats.free_list_stall_cycles;
+    sample.intFU_busy_cycles = cpu->stats.intFU_busy_cycles;
+    sample.addFU_busy_cycles = cpu->stats.addFU_busy_cycles;
+    sample.mulFU_busy_cycles = cpu->stats.mulFU_busy_cycles;
+    sample.divFU_busy_cycles = cpu->stats.divFU_busy_cycles;
+    sample.mem_busy_cycles = cpu->stats.mem_busy_cycles;
+
+    stat_sampler_push(cpu->sampler, &sample);
+}
 
-    /* Initialize PC, Registers and all pipeline stages */
-    cpu->pc = 4000;
-    memset(cpu->regs, 0, sizeof(int) * REG_FILE_SIZE);
-    memset(cpu->data_memory, 0, sizeof(int) * DATA_MEMORY_SIZE);
-    cpu->single_step = ENABLE_SINGLE_STEP;
+/*
+This method simulates the stages of the pipeline for the current clock cycle
+*/
+static void
+simulate_cycle(APEX_CPU *cpu)
+{
+    int fetch_thread;
 
-    /* Parse input file and create code memory */
-    cpu->code_memory = create_code_memory(filename, &cpu->code_memory_size);
-    if (!cpu->code_memory)
+    if (cpu->debug_messages)
     {
-        free(cpu);
-        return NULL;
+        printf("--------------------------------------------\n");
+        printf("Clock Cycle #: %d\n", cpu->clock + 1);
+        printf("--------------------------------------------\n");
     }
 
-    for (int i = 0; i < PRF_SIZE; i++)
-    {
-        cpu->cpu_prf[i].isValid = TRUE;
-        cpu->cpu_prf[i].dependency_count = 0;
-        for (int j = 0; j < IQ_SIZE; j++) {
-            cpu->cpu_prf[i].iq_dependency_list[j] = 0;
-        }
-        
-        for (int j = 0; j < LSQ_SIZE; j++) {
-            cpu->cpu_prf[i].lsq_dependency_list[j] = 0;
-        }
-        cpu->cpu_prf[i].value = -1;
-    }
+    HOST_PROFILE_START(cpu);
 
-    cpu->free_reg_head = 0;
-    cpu->free_reg_tail = 0;
+    timing_wheel_advance(&cpu->timing_wheel, cpu->clock);
 
-    for (int i = 0; i < IQ_SIZE; i++) {
-        cpu->cpu_iq[i].isValid = FALSE;
+    if (cpu->skip_idle_cycles) {
+        skip_idle_cycles(cpu);
     }
 
-    cpu->rob_head = 0;
-    cpu->rob_tail = 0;
+    account_cycles(cpu, 1);
+    HOST_PROFILE_LAP(cpu, PROF_OTHER);
 
-    cpu->lsq_head = 0;
-    cpu->lsq_tail = 0;
+    APEX_execute(cpu);
+    HOST_PROFILE_LAP(cpu, PROF_EXECUTE);
+    APEX_Godzilla(cpu);
+    HOST_PROFILE_LAP(cpu, PROF_GODZILLA_COMMIT);
 
-    for (int i = 0; i < ROB_SIZE; i++) {
-        cpu->cpu_rob[i].isValid = FALSE;
+    /* Every thread has its own front end, they rename from the shared free list in turns */
+    for (int n = 0; n < cpu->thread_count; n++) {
+        cpu->thread = &cpu->threads[(cpu->clock + n) % cpu->thread_count];
+        APEX_Dispatch(cpu);
+        HOST_PROFILE_LAP(cpu, PROF_DISPATCH);
+        APEX_Decode(cpu);
+        HOST_PROFILE_LAP(cpu, PROF_DECODE);
     }
 
-    for (int i = 0; i < LSQ_SIZE; i++) {
-        cpu->cpu_lsq[i].isValid = FALSE;
+    /* One thread fetches per cycle */
+    fetch_thread = select_fetch_thread(cpu);
+    if (fetch_thread != -1) {
+        cpu->fetch_thread = fetch_thread;
+        cpu->thread = &cpu->threads[fetch_thread];
+        APEX_fetch(cpu);
     }
+    HOST_PROFILE_LAP(cpu, PROF_FETCH);
 
-    for (int i = 0; i < REG_FILE_SIZE; i++) {
-        cpu->rename_table[i] = -1;
+    if (cpu->debug_messages) {
+        print_prf(cpu);
+        for (int t = 0; t < cpu->thread_count; t++) {
+            cpu->thread = &cpu->threads[t];
+            print_reg_file(cpu);
+        }
     }
 
-    for (int i = 0; i < PRF_SIZE; i++) {
-        cpu->free_reg_list[i] = i;
+    if (cpu->sampler && cpu->clock + 1 >= cpu->sampler->next_cycle) {
+        take_sample(cpu, cpu->clock + 1);
     }
 
-    cpu->free_reg_head = 0;
-    cpu->free_reg_tail = 0;
-    printf("\nFree list of registers: \n");
-    for (int i = cpu->free_reg_head + 1; i != cpu->free_reg_tail; i = (i + 1)%PRF_SIZE) {
-        printf("%d\t", cpu->free_reg_list[i-1]);
+    if (cpu->halt_cpu && cpu->mem_dump_file) {
+        if (!memory_image_dump(&cpu->data_memory, cpu->mem_dump_file, cpu->mem_dump_start, cpu->mem_dump_count)) {
+            fprintf(stderr, "APEX_Error: Unable to dump data memory to %s\n", cpu->mem_dump_file);
+        }
     }
-    printf("\n\n");
-
-    cpu->execute.addFU.has_insn = FALSE;
-    cpu->execute.addFU.forwarded_from_mul = 0;
-    cpu->execute.intFU.has_insn = FALSE;
-    cpu->execute.intFU.forwarded_from_mul = 0;
-    cpu->execute.mulFU.has_insn = FALSE;
-    cpu->execute.mulFU.forwarded_from_mul = 0;
-    cpu->execute.mulFU_clock = 0;
-    cpu->execute.is_halt_insn = FALSE;
-
-    cpu->godzilla.intfu_ready_insn = -1;
-    cpu->godzilla.addfu_ready_insn = -1;
-    cpu->godzilla.mulfu_ready_insn = -1;
-    cpu->godzilla.lsq_target = -1;
-    cpu->godzilla.mem_stage_clock = 0;
-    cpu->godzilla.has_insn = FALSE;
-    cpu->godzilla.enter_godzilla = TRUE;
-
-    cpu->decode_rename.has_insn = FALSE;
-    cpu->rename_dispatch.has_insn = FALSE;
+}
 
-    cpu->intFU_broadcasted_tag = -1;
-    cpu->mulFU_broadcasted_tag = -1;
-    cpu->addFU_broadcasted_tag = -1;
+/*
+ * This function simulates one clock cycle and moves the clock on, it returns TRUE once the CPU has halted
+ */
+int
+APEX_cpu_step(APEX_CPU *cpu)
+{
+    if (cpu->halt_cpu)
+    {
+        return TRUE;
+    }
 
-    cpu->halt_cpu = FALSE;
+    simulate_cycle(cpu);
 
-    if (ENABLE_DEBUG_MESSAGES)
+    if (!cpu->halt_cpu)
     {
-        fprintf(stderr,
-                "APEX_CPU: Initialized APEX CPU, loaded %d instructions\n",
-                cpu->code_memory_size);
-        fprintf(stderr, "APEX_CPU: PC initialized to %d\n", cpu->pc);
-        fprintf(stderr, "APEX_CPU: Printing Code Memory\n");
-        printf("%-9s %-9s %-9s %-9s %-9s\n", "opcode_str", "rd", "rs1", "rs2",
-               "imm");
-
-        for (i = 0; i < cpu->code_memory_size; ++i)
-        {
-            printf("%-9s %-9d %-9d %-9d %-9d\n", cpu->code_memory[i].opcode_str,
-                   cpu->code_memory[i].rd, cpu->code_memory[i].rs1,
-                   cpu->code_memory[i].rs2, cpu->code_memory[i].imm);
-        }
+        cpu->clock++;
     }
 
-    /* To start fetch stage */
-    cpu->fetch.has_insn = TRUE;
-    return cpu;
-}
-
-/*
-This method is used to print the contents of the stage after every clock cycle
-*/
-void print_cpu_status (APEX_CPU *cpu) {
-    print_stage_content("Fetch", &cpu->fetch);
-    print_stage_content("Decode1", &cpu->decode_rename);
-    print_stage_content("Decode2", &cpu->rename_dispatch);
-    print_godzilla(cpu);
-    print_execute(cpu);
+    return cpu->halt_cpu;
 }
 
 /*
@@ -1929,42 +3996,25 @@ APEX_cpu_run(APEX_CPU *cpu)
 
     while (TRUE)
     {
-        // if (cpu->clock >= cpu->cycles_limit)
-        // {
-        //     printf("\nYou've exhausted all the clock cycles!\n");
-        //     break;
-        // }
+        simulate_cycle(cpu);
 
-        if (ENABLE_DEBUG_MESSAGES)
-        {
-            printf("--------------------------------------------\n");
-            printf("Clock Cycle #: %d\n", cpu->clock + 1);
-            printf("--------------------------------------------\n");
+        if (cpu->halt_cpu) {
+            break;
         }
 
-        // if (APEX_Dispatch(cpu))
-        // {
-        //     /* Halt in writeback stage */
-        //     printf("APEX_CPU: Simulation Complete, cycles = %d instructions = %d\n", cpu->clock, cpu->insn_completed);
-        //     print_reg_file(cpu);
-        //     break;
-        // }
-
-        APEX_execute(cpu);
-        APEX_Godzilla(cpu);
-        APEX_Dispatch(cpu);
-        APEX_Decode(cpu);
-        APEX_fetch(cpu);
-
-        print_prf(cpu);
-        print_reg_file(cpu);
-
-        if (cpu->halt_cpu) {
+        if (cpu->cycles_limit > 0 && cpu->clock + 1 >= cpu->cycles_limit) {
+            cpu->clock++;
+            printf("APEX_CPU: Simulation Stopped, cycles = %d instructions = %d\n", cpu->clock, cpu->insn_completed);
             break;
         }
 
         // print_cpu_status(cpu);
 
+        if (!cpu->single_step) {
+            cpu->clock++;
+            continue;
+        }
+
         printf("Press any key to advance CPU Clock or <q> to quit or <d> to display register files:\n");
         scanf("%c", &user_prompt_val);
 
@@ -2003,7 +4053,119 @@ APEX_cpu_run(APEX_CPU *cpu)
         cpu->clock++;
     }
 
-    print_reg_file(cpu);
+    if (cpu->single_step || cpu->debug_messages) {
+        print_reg_file(cpu);
+        print_stats(cpu);
+    }
+
+#if ENABLE_HOST_PROFILING
+    print_host_profile(cpu);
+#endif
+}
+
+/*
+ * This function preloads data memory from an image file, the first word lands at address base.
+ * It must be called before the first cycle, the co-simulation reference models get the same contents.
+ */
+int
+APEX_cpu_load_memory_image(APEX_CPU *cpu, const char *filename, int base)
+{
+    if (!memory_image_load(&cpu->data_memory, filename, base))
+    {
+        fprintf(stderr, "APEX_Error: Unable to load data memory image %s\n", filename);
+        return FALSE;
+    }
+
+    for (int t = 0; t < cpu->thread_count; t++)
+    {
+        data_memory_free(&cpu->threads[t].golden.data_memory);
+        if (!data_memory_copy(&cpu->threads[t].golden.data_memory, &cpu->data_memory))
+        {
+            fprintf(stderr, "APEX_Error: Unable to copy data memory image to the reference model\n");
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/*
+ * This function makes the program start at pc instead of the first instruction of code memory.
+ * It must be called before the first cycle, the co-simulation reference model starts there too.
+ */
+int
+APEX_cpu_set_entry_pc(APEX_CPU *cpu, int pc)
+{
+    int code_index = get_code_memory_index_from_pc(pc);
+
+    if (pc % 4 != 0 || code_index < 0 || code_index >= cpu->thread->code_memory_size)
+    {
+        fprintf(stderr, "APEX_Error: Entry pc(%d) is outside the code memory\n", pc);
+        return FALSE;
+    }
+
+    cpu->thread->pc = pc;
+    cpu->thread->golden.pc = pc;
+
+    return TRUE;
+}
+
+/*
+ * This function starts writing a pipeline trace of every retired instruction to a file in the
+ * O3PipeView format. It must be called before the first cycle.
+ */
+int
+APEX_cpu_trace_pipeview(APEX_CPU *cpu, const char *filename)
+{
+    cpu->pipeview = pipeview_open(filename);
+    if (!cpu->pipeview)
+    {
+        fprintf(stderr, "APEX_Error: Unable to write pipeline trace %s\n", filename);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*
+ * This function starts writing the run counters to a CSV file every interval cycles, 0 for the
+ * default interval. It must be called before the first cycle.
+ */
+int
+APEX_cpu_sample_stats(APEX_CPU *cpu, const char *filename, int interval)
+{
+    cpu->sampler = stat_sampler_open(filename, interval);
+    if (!cpu->sampler)
+    {
+        fprintf(stderr, "APEX_Error: Unable to write interval statistics %s\n", filename);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*
+ * This function prints the program loaded into code memory
+ */
+void
+APEX_cpu_print_code_memory(const APEX_CPU *cpu)
+{
+    int i;
+
+    fprintf(stderr,
+            "APEX_CPU: Initialized APEX CPU, loaded %d instructions\n",
+            cpu->thread->code_memory_size);
+    fprintf(stderr, "APEX_CPU: PC initialized to %d\n", cpu->thread->pc);
+    fprintf(stderr, "APEX_CPU: Printing Code Memory\n");
+    printf("%-9s %-9s %-9s %-9s %-9s\n", "opcode_str", "rd", "rs1", "rs2",
+           "imm");
+
+    for (i = 0; i < cpu->thread->code_memory_size; ++i)
+    {
+        printf("%-9s %-9d %-9d %-9d %-9d\n", cpu->thread->code_memory[i].opcode_str,
+               cpu->thread->code_memory[i].rd, cpu->thread->code_memory[i].rs1,
+               cpu->thread->code_memory[i].rs2, cpu->thread->code_memory[i].imm);
+    }
 }
 
 /*
@@ -2014,7 +4176,19 @@ APEX_cpu_run(APEX_CPU *cpu)
 void
 APEX_cpu_stop(APEX_CPU *cpu)
 {
-    free(cpu->code_memory);
+    /* The last, partial interval */
+    if (cpu->sampler && cpu->clock > cpu->sampler->pushed_cycle) {
+        take_sample(cpu, cpu->clock);
+    }
+
+    stat_sampler_close(cpu->sampler);
+    pipeview_close(cpu->pipeview);
+    for (int t = 0; t < cpu->thread_count; t++)
+    {
+        free(cpu->threads[t].code_memory);
+        golden_model_free(&cpu->threads[t].golden);
+    }
+    data_memory_free(&cpu->data_memory);
     free(cpu);
 }
 
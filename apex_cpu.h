@@ -10,6 +10,19 @@
 #define _APEX_CPU_H_
 
 #include "apex_macros.h"
+#include "data_memory.h"
+#include "timing_wheel.h"
+#include "golden_model.h"
+#include "host_profile.h"
+#include "bitset.h"
+#include "tag_cam.h"
+#include "pipeview.h"
+#include "stat_sampler.h"
+#include "target_predictor.h"
+#include "value_predictor.h"
+#include "data_cache.h"
+#include "stride_prefetcher.h"
+#include "store_log.h"
 
 /* Format of an APEX instruction  */
 typedef struct APEX_Instruction
@@ -44,14 +57,26 @@ typedef struct CPU_Stage
     int memory_address;
     int has_insn;
     int lpsp_inc_dest;
+    int lpsp_overwritten_pd;    // Previous mapping of the LOADP/STOREP base register, -1 if none
+    int seq;                    // Fetch sequence number, identifies the instruction in the pipeline trace
+    int cc_pd;                  // Condition code register the instruction writes, -1 if none
+    int cc_overwritten_pd;      // Previous mapping of the flags, released at retirement
+    int cc_ps;                  // Condition code register a branch reads
+    int pred_target;            // Target fetch predicted for a JUMP/JALR
+    int pred_source;            // TARGET_PRED_* predictor that supplied pred_target
+    Ras_State ras_state;        // Return-address stack after the fetch of a branch
+    int checkpoint;             // Rename checkpoint taken at a branch or value-predicted load, -1 if none
+    int pred_value;             // Value predicted for a LOAD/LOADP that took a checkpoint
+    int eliminated;             // Completed at rename, takes no IQ entry or FU
+    int fused_opcode;           // Instruction at pc + 4 fused into this one, -1 if none
+    int fused_imm;              // Offset of the fused branch, constant of the fused MOVC
+    int fused_rd;               // Register written by a MOVC fused ahead of this instruction, -1 if none
+    int fused_pd;
+    int fused_overwritten_pd;
+    int fused_seq;              // Fetch sequence number of the fused instruction
     //Comment
 } CPU_Stage;
 
-typedef struct Mem_insn_reg_updt {
-    int dest;
-    int incr_dest;
-} Mem_insn_reg_updt;
-
 /* Model of CPU stage latch */
 typedef struct CPU_Godzilla
 {
@@ -75,15 +100,28 @@ typedef struct CPU_Godzilla
     int result_buffer;
     int memory_address;
     int has_insn;
+    int insn_pending;   // TRUE while the dispatched instruction has not been entered into the IQ/ROB/LSQ
     int enter_godzilla; // This specifies if dispatch should happen or not
     int lsq_index;      // This is the index allocated for the load/store instruction arrived at the Godzilla at the current cycle
-    int intfu_ready_insn;
-    int mulfu_ready_insn;
-    int addfu_ready_insn;
-    int lsq_target;
-    int mem_stage_clock;
+    int stall_cause;    // STALL_* reason enter_godzilla is FALSE
     int lpsp_inc_dest;
-    Mem_insn_reg_updt mem_insn_reg_updt;
+    int lpsp_overwritten_pd;
+    int seq;
+    int cc_pd;
+    int cc_overwritten_pd;
+    int cc_ps;
+    int rob_index;      // ROB entry allocated for the instruction
+    int pred_target;
+    int pred_source;
+    int checkpoint;
+    int pred_value;
+    int eliminated;
+    int fused_opcode;
+    int fused_imm;
+    int fused_rd;
+    int fused_pd;
+    int fused_overwritten_pd;
+    int fused_seq;
 } CPU_Godzilla;
 
 typedef struct CPU_FU {
@@ -102,6 +140,12 @@ typedef struct CPU_FU {
     int imm;
     int forwarded_from_mul;
     int lpsp_inc_dest;
+    int seq;
+    int pc;
+    int rob_index;
+    int fused_opcode;
+    int fused_imm;
+    int thread;         // Hardware thread of the instruction
 } CPU_FU;
 
 typedef struct CPU_Execute {
@@ -109,7 +153,9 @@ typedef struct CPU_Execute {
     CPU_FU intFU;
     CPU_FU mulFU;
     CPU_FU addFU;
+    CPU_FU divFU;
     int mulFU_clock;
+    int divFU_clock;
     int is_halt_insn;
 } CPU_Execute;
 
@@ -124,29 +170,41 @@ typedef struct CPU_PRF
 {
     int isValid;
     int value;
-    int dependency_count;
-    int iq_dependency_list[IQ_SIZE];
-    int lsq_dependency_list[LSQ_SIZE];
-    int broadcast_valid;
-    int broadcast_value;
+    int pending_retires; // ROB entries that copy the register to the architectural file when they retire
+    int refs;           // Renames sharing the register, it is freed when the last one is released
 } CPU_PRF;
 
+/* Payload of an IQ entry, only read once the entry is selected for issue */
 typedef struct CPU_IQ
 {
-    int isValid;
-    int FU;             // if 1, the function unit is IntFU; if 2, the function unit is MulFU; if 3, the function unit is AFU
-    int function_type;  // if 1, the fucntion type is addition; if 2, the function type is subraction => Applies only to IntFU
+    int FU;             // INT_FU, ADD_FU, MUL_FU or DIV_FU
+    int function_type;  // Opcode of the instruction
     int literal;
-    int ps1_valid;
-    int ps1_tag;
-    int ps2_valid;
-    int ps2_tag;
     int dest_type;      // if 0, destination is PRF; if 1, destination is LSQ
     int dest;
-    int clock_cycle_at_dispatch;    // This denotes at which cycle the instruction was dispatched
     int lpsp_inc_dest;
+    int seq;
+    int cc_dest;        // Condition code register written, -1 if none
+    int pc;             // Needed by branches for their target
+    int rob_index;
+    int fused_opcode;   // Branch fused behind a CMP/CML, -1 if none
+    int fused_imm;
+    int thread;         // Hardware thread of the instruction
 } CPU_IQ;
 
+/* Scheduler state of the IQ scanned by wakeup and select every cycle, one bit or one slot per entry */
+typedef struct CPU_IQ_Sched
+{
+    uint64_t valid[IQ_WORDS];
+    uint64_t free[IQ_WORDS];
+    uint64_t ps1_ready[IQ_WORDS];
+    uint64_t ps2_ready[IQ_WORDS];
+    uint64_t fu_class[FU_CLASSES][IQ_WORDS];    // Entries issuing to INT_FU, ADD_FU, MUL_FU and DIV_FU
+    int ps1_tag[IQ_SIZE];
+    int ps2_tag[IQ_SIZE];
+    int age[IQ_SIZE];                           // Cycle the instruction entered the IQ, oldest issues first
+} CPU_IQ_Sched;
+
 typedef struct CPU_LSQ
 {
     int isValid;
@@ -171,8 +229,48 @@ typedef struct CPU_ROB
     int rd;
     int lsq_index;
     int mem_error_codes;
+    int lpsp_rd;        // Architectural register post-incremented by LOADP/STOREP, -1 if none
+    int lpsp_pd;        // Physical register holding the post-incremented value
+    int lpsp_overwritten_pd;    // Previous mapping of lpsp_rd, released at retirement
+    int seq;
+    int cc_pd;          // Condition code register written, -1 if none
+    int cc_overwritten_pd;
+    int completed;      // Set when a branch has resolved
+    int pred_target;    // Target predicted at fetch for a JUMP/JALR
+    int pred_source;    // TARGET_PRED_* predictor that supplied it
+    int checkpoint;     // Rename checkpoint of a branch or value-predicted load, -1 if none
+    int fused;          // TRUE if the entry retires a fused pair, the second instruction is at pc + 4
+    int fused_rd;       // Register written by a fused MOVC, retired ahead of rd, -1 if none
+    int fused_pd;
+    int fused_overwritten_pd;
+    int fused_seq;      // Fetch sequence number of the second instruction of a fused pair
 } CPU_ROB;
 
+/* Rename state right after a branch was renamed, restored when the branch mispredicts */
+typedef struct Rename_Checkpoint
+{
+    int isValid;
+    int seq;                            // Branch the checkpoint belongs to
+    int rename_table[REG_FILE_SIZE];
+    uint64_t allocated[PRF_WORDS];      // Physical registers allocated since, handed back on a flush
+    int shared[PRF_SIZE];               // References taken since by eliminated moves, dropped on a flush
+    int cc_rename;
+    int cc_free_head;
+    int cc_free_allocs;
+    Ras_State ras_state;
+} Rename_Checkpoint;
+
+/* Fetch latches of a loop body, from the target of its backward branch to the branch */
+typedef struct Loop_Buffer
+{
+    int state;                          // LOOP_BUFFER_IDLE, _CAPTURE or _REPLAY
+    int start_pc;
+    int end_pc;                         // PC of the loop branch
+    uint64_t captured;                  // Bit set for every entry captured so far
+    uint64_t complete;                  // Bits of the entries of the whole body
+    CPU_Stage entries[LOOP_BUFFER_SIZE];
+} Loop_Buffer;
+
 // typedef struct CPU_Godzilla
 // {
 //     int pc;
@@ -199,50 +297,134 @@ typedef struct CPU_ROB
 //     int lsq_index;      // This is the index allocated for the load/store instruction arrived at the Godzilla at the current cycle
 // } CPU_Godzilla;
 
-/* Model of APEX CPU */
-typedef struct APEX_CPU
+typedef struct CPU_Stats
+{
+    long long cycles_skipped;           /* Idle cycles jumped over by the event scheduler */
+    long long intFU_busy_cycles;        /* Cycles the INT FU held an instruction */
+    long long addFU_busy_cycles;        /* Cycles the address FU held an instruction */
+    long long mulFU_busy_cycles;        /* Cycles the MUL FU held an instruction */
+    long long divFU_busy_cycles;        /* Cycles the DIV FU held an instruction */
+    long long mem_busy_cycles;          /* Cycles a memory access was in flight */
+    long long dispatch_stall_cycles;    /* Cycles an instruction waited in dispatch */
+    long long iq_full_stall_cycles;     /* ... of which the IQ was full */
+    long long rob_full_stall_cycles;    /* ... of which the ROB was full */
+    long long lsq_full_stall_cycles;    /* ... of which the LSQ was full */
+    long long free_list_stall_cycles;   /* Cycles rename waited for free physical registers */
+    long long branch_stall_cycles;      /* Cycles fetch waited for a branch to resolve */
+    long long branches;                 /* Conditional branches executed */
+    long long branches_taken;
+    long long ras_predictions;          /* Returns predicted by the return-address stack */
+    long long ras_correct;
+    long long itt_predictions;          /* JUMP/JALR predicted by the indirect-target table */
+    long long itt_correct;
+    long long indirect_unpredicted;     /* JUMP/JALR fetched with no prediction */
+    long long branch_mispredicts;       /* Branches that flushed the path fetched after them */
+    long long insns_squashed;           /* Instructions flushed past rename */
+    long long regs_released_early;      /* Physical registers freed before their redefinition retired */
+    long long moves_eliminated;         /* Register moves renamed onto their source register */
+    long long consts_materialized;      /* MOVC and zero idioms written to the PRF at rename */
+    long long fused_pairs;              /* Instruction pairs retired from a single fused ROB entry */
+    long long loop_buffer_insns;        /* Instructions fetched from the loop buffer instead of code memory */
+    long long value_predictions;        /* Loads whose value was predicted at dispatch */
+    long long value_mispredicts;        /* ... of which the value was wrong and flushed the younger instructions */
+    long long dcache_accesses;          /* Loads and stores performed from the LSQ */
+    long long dcache_misses;            /* ... of which the line was not in the cache */
+    long long prefetches;               /* Lines the stride prefetcher started filling */
+    long long prefetches_useful;        /* ... of which a demand access used the line */
+    long long prefetches_late;          /* ... of which the demand access still waited for the fill */
+} CPU_Stats;
+
+/* Architectural and in-flight state of one hardware thread. The threads of a core share its IQ, PRF,
+   FUs, data cache and data memory, and each has its own front end, rename state, ROB and LSQ. */
+typedef struct APEX_Thread
 {
+    int id;                        /* Index in APEX_CPU.threads */
     int pc;                        /* Current program counter */
-    int clock;                     /* Clock cycles elapsed */
-    int cycles_limit;              /* Sets the maximum number of cycles the CPU is initialized to run for */
-    int enable_forwarding;         /* Sets the user choice of using forwarding */
-    int insn_completed;            /* Instructions retired */
-    int has_stalled;               /* Indicates whether instruction has been stalled */
+    int insn_completed;            /* Instructions retired by the thread */
+    int halt_cycle;                /* Cycle the HALT of the thread retired, -1 while it runs */
+    int last_retired_pc;           /* PC of the most recently retired instruction, -1 before the first */
     int regs[REG_FILE_SIZE];       /* Integer register file */
     int code_memory_size;          /* Number of instruction in the input file */
     APEX_Instruction *code_memory; /* Code Memory */
-    int data_memory[DATA_MEMORY_SIZE]; /* Data Memory */
-    int single_step;               /* Wait for user input after every cycle */
     int zero_flag;                 /* {TRUE, FALSE} Used by BZ and BNZ to branch */
     int positive_flag;              /* {TRUE, FALSE} Used by BP and BNP to branch */
     int negative_flag;             /* {TRUE, FALSE} Used by BN and BNN to branch */
-    int fetch_from_next_cycle;
-    int decode_from_next_cycle;
-    int dispatch_from_next_cycle;
-    int overwritten_pd;
-
-    int sim_n;
 
     /* Pipeline stages */
     CPU_Stage fetch;
+    CPU_Stage fetch_buffer;        /* Instruction fetched while decode held the previous one, decode takes it next */
     CPU_Stage decode_rename;
     CPU_Stage rename_dispatch;
     CPU_Godzilla godzilla;
-    CPU_Execute execute;
-    
-    CPU_IQ cpu_iq[IQ_SIZE];
+
     CPU_LSQ cpu_lsq[LSQ_SIZE];
+    int lsq_ps1_tag[LSQ_SIZE];     /* Dense copy of cpu_lsq[].ps1_tag searched by the wakeup CAM */
     int lsq_head;
     int lsq_tail;
     CPU_ROB cpu_rob[ROB_SIZE];
     int rob_head;
     int rob_tail;
-    CPU_PRF cpu_prf[PRF_SIZE];
 
     int rename_table[REG_FILE_SIZE];    /* Index: Regs || Value: Physical Regs */
-    int free_reg_list[PRF_SIZE];
-    int free_reg_head;
-    int free_reg_tail;
+
+    int cc_rename;                 /* Condition code register holding the latest flags, -1 before the first */
+    int cc_free_list[CPRF_SIZE];   /* The CPRF_SIZE condition code registers of the thread */
+    int cc_free_head;
+    int cc_free_tail;
+    int cc_free_count;
+    int cc_free_allocs;
+
+    Rename_Checkpoint checkpoints[CHECKPOINT_COUNT];
+
+    Loop_Buffer loop_buffer;       /* Loop body fetch replays instead of decoding and predicting it again */
+
+    int branch_in_flight;          /* Fetch waits while a JUMP/JALR with no predicted target has not resolved */
+
+    Target_Predictor target_pred;  /* RAS and indirect-target table of JUMP/JALR */
+    Value_Predictor value_pred;    /* Last value and stride of the loads */
+    Golden_Model golden;           /* Functional reference model */
+} APEX_Thread;
+
+/* Model of APEX CPU */
+typedef struct APEX_CPU
+{
+    APEX_Thread threads[SMT_THREADS_MAX];
+    APEX_Thread *thread;           /* Thread the stage being simulated works on */
+    int thread_count;              /* Hardware threads running a program */
+    int fetch_policy;              /* SMT_FETCH_*, picks the thread fetching in a cycle */
+    int queue_policy;              /* SMT_QUEUES_*, divides the ROB and LSQ between the threads */
+    int fetch_thread;              /* Thread that fetched last */
+    int clock;                     /* Clock cycles elapsed */
+    int cycles_limit;              /* Sets the maximum number of cycles the CPU is initialized to run for */
+    int enable_forwarding;         /* Sets the user choice of using forwarding */
+    int insn_completed;            /* Instructions retired */
+    int fetch_seq;                 /* Sequence number given to the next fetched instruction */
+    int has_stalled;               /* Indicates whether instruction has been stalled */
+    Data_Memory data_memory;       /* Data Memory */
+    const char *mem_dump_file;     /* Data memory is dumped to this file at HALT, NULL for none */
+    int mem_dump_start;            /* First word of the dump */
+    int mem_dump_count;            /* Words dumped, 0 for the whole memory */
+    int single_step;               /* Wait for user input after every cycle */
+    int debug_messages;            /* Print the pipeline contents every cycle */
+
+    int sim_n;
+
+    CPU_Execute execute;
+    int intfu_ready_insn;          /* IQ entries selected for issue to every FU, -1 for none */
+    int mulfu_ready_insn;
+    int divfu_ready_insn;
+    int addfu_ready_insn;
+    int mem_stage_clock;           /* Cycles the memory access in flight has taken, 0 if the port is free */
+    APEX_Thread *mem_port_thread;  /* Thread of the memory access in flight */
+
+    CPU_IQ cpu_iq[IQ_SIZE];
+    CPU_IQ_Sched iq_sched;
+    CPU_PRF cpu_prf[PRF_SIZE];
+    CPU_PRF cpu_cprf[CPRF_SIZE * SMT_THREADS_MAX];  /* Condition code registers, the value holds FLAG_* bits */
+
+    uint64_t free_regs[PRF_WORDS]; /* Bit set for every free physical register */
+    int free_reg_count;            /* Physical registers free */
+    int prf_size;                  /* Physical registers in use, PRF_BASE_SIZE and REG_FILE_SIZE more for every further thread */
 
     /* entry index of BTB */
     int btb_insert_at;
@@ -253,12 +435,30 @@ typedef struct APEX_CPU
     int intcc_broadcast_value;
     int addFU_broadcasted_tag;
     int addFU_broadcasted_value;
+    int addFU_broadcasted_thread;  /* Thread of the LSQ entry addFU_broadcasted_tag indexes */
     int mulFU_broadcasted_tag;
     int mulFU_broadcasted_value;
     int mulcc_broadcast_tag;
     int mulcc_broadcast_value;
+    int wakeup_tags[WAKEUP_TAGS_MAX];   /* Result tags broadcast since the last wakeup phase */
+    int wakeup_tag_count;
 
     int halt_cpu;
+
+    Timing_Wheel timing_wheel;     /* Pending FU completions and memory responses */
+    int skip_idle_cycles;          /* Jump the clock to the next event when the pipeline is idle */
+    CPU_Stats stats;
+    Data_Cache dcache;             /* Tags and fill times of the data cache */
+    Stride_Prefetcher prefetcher;  /* Address streams of the loads and stores */
+    Store_Log *store_log;          /* Stores the other cores have not seen yet, NULL unless the CPU is a core of a multi-core run */
+
+    int cosim_enabled;             /* Step the reference model at every retirement and compare */
+    int cosim_failed;              /* Set once the pipeline diverged from the reference model */
+    Pipeview *pipeview;            /* Pipeline trace being written, NULL if tracing is off */
+    Stat_Sampler *sampler;         /* Interval statistics being written, NULL if sampling is off */
+#if ENABLE_HOST_PROFILING
+    Host_Profile host_profile;     /* Host time spent in every simulator stage */
+#endif
 } APEX_CPU;
 
 
@@ -266,7 +466,14 @@ typedef struct APEX_CPU
 
 APEX_Instruction *create_code_memory(const char *filename, int *size);
 APEX_CPU *APEX_cpu_init(const char *filename);
+int APEX_cpu_add_thread(APEX_CPU *cpu, const char *filename);
 void APEX_cpu_run(APEX_CPU *cpu);
+int APEX_cpu_step(APEX_CPU *cpu);
+int APEX_cpu_load_memory_image(APEX_CPU *cpu, const char *filename, int base);
+int APEX_cpu_set_entry_pc(APEX_CPU *cpu, int pc);
+int APEX_cpu_trace_pipeview(APEX_CPU *cpu, const char *filename);
+int APEX_cpu_sample_stats(APEX_CPU *cpu, const char *filename, int interval);
+void APEX_cpu_print_code_memory(const APEX_CPU *cpu);
 void APEX_cpu_stop(APEX_CPU *cpu);
 void ns_print_stage_content(const char *name, const CPU_Stage *stage);
 void ns_print_reg_file(const APEX_CPU *cpu);
@@ -12,15 +12,52 @@
 #define FALSE 0x0
 #define TRUE 0x1
 
-/* Integers */
-#define DATA_MEMORY_SIZE 4096
+/* Data memory size in words, must be a multiple of the page size */
+#define DATA_MEMORY_SIZE (1 << 24)
+
+/* Data memory is allocated lazily in pages of 2^DATA_MEMORY_PAGE_BITS words */
+#define DATA_MEMORY_PAGE_BITS 10
+#define DATA_MEMORY_PAGE_SIZE (1 << DATA_MEMORY_PAGE_BITS)
+#define DATA_MEMORY_PAGES (DATA_MEMORY_SIZE / DATA_MEMORY_PAGE_SIZE)
+
+/* Error codes recorded in a ROB entry by the memory stage and the divider */
+#define MEM_ERROR_NONE 0
+#define MEM_ERROR_OUT_OF_BOUNDS 1
+#define MEM_ERROR_DIV_BY_ZERO 2
 
 /* Size of integer register file */
 #define REG_FILE_SIZE 16
 
-#define PRF_SIZE 25
-#define CPRF_SIZE 16
+/* Hardware threads a core can run at once */
+#define SMT_THREADS_MAX 4
+
+/* Physical registers of a core running one thread, every further thread brings REG_FILE_SIZE more for
+   its architectural registers */
+#define PRF_BASE_SIZE 25
+#define PRF_SIZE (PRF_BASE_SIZE + REG_FILE_SIZE * (SMT_THREADS_MAX - 1))
+#define PRF_WORDS BITSET_WORDS(PRF_SIZE)
+#ifndef PRF_EARLY_RELEASE
+#define PRF_EARLY_RELEASE 1    /* Free an overwritten register once it is dead, before its redefinition retires */
+#endif
+#ifndef RENAME_ELIMINATION
+#define RENAME_ELIMINATION 1   /* Complete moves, zero idioms and MOVC at rename */
+#endif
+#ifndef MACRO_OP_FUSION
+#define MACRO_OP_FUSION 1      /* Rename CMP/CML + branch and MOVC + ADD/SUB/MUL pairs as one instruction */
+#endif
+#ifndef LOOP_BUFFER
+#define LOOP_BUFFER 1          /* Fetch short loop bodies from the loop buffer, decoded and predicted as when captured */
+#endif
+#define LOOP_BUFFER_SIZE 16    /* Instructions of the longest loop body the loop buffer holds, at most 64 */
+#ifndef LOAD_VALUE_PREDICTION
+#define LOAD_VALUE_PREDICTION 1 /* Predict the value of LOAD/LOADP at dispatch, verify it when the load completes */
+#endif
+#define CPRF_SIZE 16           /* Condition code registers of every thread */
+#define CHECKPOINT_COUNT 8     /* Branches and value-predicted loads that can be in flight past rename */
+#ifndef IQ_SIZE
 #define IQ_SIZE 24
+#endif
+#define IQ_WORDS BITSET_WORDS(IQ_SIZE)
 #define LSQ_SIZE 16
 #define ROB_SIZE 32
 
@@ -28,10 +65,89 @@
 #define dest_branch 1001
 #define dest_halt 1002
 #define dest_loadp_storep 1003
+#define dest_none 1004
+
+/* Error codes reported by the co-simulation reference model */
+#define GOLDEN_ERROR_NONE 0
+#define GOLDEN_ERROR_BAD_PC 1
+#define GOLDEN_ERROR_MEMORY 2
+#define GOLDEN_ERROR_DIV_BY_ZERO 3
+
+/* Latencies of the multi-cycle units, in cycles */
+#ifndef MUL_FU_LATENCY
+#define MUL_FU_LATENCY 3
+#endif
+#ifndef MEM_ACCESS_LATENCY
+#define MEM_ACCESS_LATENCY 2    /* Data cache hit */
+#endif
+#ifndef MEM_MISS_LATENCY
+#define MEM_MISS_LATENCY 16     /* Data cache miss, the line is filled from memory */
+#endif
+
+/* Stride prefetcher: lines prefetched per access, 0 turns it off, and lines ahead of the access the
+   first one is */
+#ifndef PREFETCH_DEGREE
+#define PREFETCH_DEGREE 1
+#endif
+#ifndef PREFETCH_DISTANCE
+#define PREFETCH_DISTANCE 1
+#endif
+
+/* The divider is not pipelined. With early out enabled a divide takes one cycle plus one for every
+   DIV_FU_BITS_PER_CYCLE bits of quotient, otherwise always DIV_FU_LATENCY cycles. */
+#define DIV_FU_LATENCY 9
+#define DIV_FU_EARLY_OUT 1
+#define DIV_FU_BITS_PER_CYCLE 4
+
+/* Event scheduler: slots must be a power of two, an event due further ahead waits for further turns of the wheel */
+#define TIMING_WHEEL_SLOTS 64
+#define TIMING_WHEEL_SLOT_DEPTH 4
+
+/* Event types, one bit each */
+#define EVENT_MUL_DONE 0x1
+#define EVENT_MEM_DONE 0x2
+#define EVENT_DIV_DONE 0x4
 
 #define INT_FU 2000
 #define ADD_FU 2001
 #define MUL_FU 2002
+#define DIV_FU 2003
+#define FU_CLASSES 4
+
+/* Why dispatch is holding the instruction in rename/dispatch */
+#define STALL_NONE 0
+#define STALL_IQ_FULL 1
+#define STALL_ROB_FULL 2
+#define STALL_LSQ_FULL 3
+#define STALL_HALT 4
+
+/* Thread an SMT core fetches for in a cycle: the next one in turn, or the one with the fewest
+   instructions between decode and issue */
+#define SMT_FETCH_ROUND_ROBIN 0
+#define SMT_FETCH_ICOUNT 1
+
+/* How the threads of an SMT core divide the ROB and the LSQ: an equal share each, or entries taken by
+   whichever thread dispatches first */
+#define SMT_QUEUES_PARTITIONED 0
+#define SMT_QUEUES_SHARED 1
+
+/* Loop buffer states */
+#define LOOP_BUFFER_IDLE 0
+#define LOOP_BUFFER_CAPTURE 1
+#define LOOP_BUFFER_REPLAY 2
+
+/* Result tags that can be broadcast between two wakeup phases: the load the memory port completes, the
+   results and flags of the INT, MUL and DIV FUs, the post-increment of the address FU and the
+   value-predicted load dispatched by every thread */
+#define WAKEUP_TAGS_MAX (1 + 2 * 3 + 1 + SMT_THREADS_MAX)
+
+/* Condition code physical registers are broadcast on the wakeup bus after the integer ones */
+#define CC_TAG(cc) (PRF_SIZE + (cc))
+
+/* Bits of a condition code register */
+#define FLAG_ZERO 0x1
+#define FLAG_POSITIVE 0x2
+#define FLAG_NEGATIVE 0x4
 
 /* Numeric OPCODE identifiers for instructions */
 #define OPCODE_ADD 0x0
@@ -67,4 +183,24 @@
 /* Set this flag to 1 to enable cycle single-step mode */
 #define ENABLE_SINGLE_STEP 1
 
+/* Set this flag to 1 to check every retired instruction against the functional reference model */
+#ifndef ENABLE_COSIM
+#define ENABLE_COSIM 1
+#endif
+
+/* Set this flag to 1 to jump over cycles in which the pipeline only waits on scheduled events */
+#ifndef ENABLE_IDLE_CYCLE_SKIP
+#define ENABLE_IDLE_CYCLE_SKIP 1
+#endif
+
+/* Set this flag to 1 to charge the host time of every simulator stage and report it at the end of a run */
+#ifndef ENABLE_HOST_PROFILING
+#define ENABLE_HOST_PROFILING 0
+#endif
+
+/* Set this flag to 1 to match broadcast tags with SSE2/AVX2 compares when the compiler targets them */
+#ifndef ENABLE_SIMD_CAM
+#define ENABLE_SIMD_CAM 1
+#endif
+
 #endif
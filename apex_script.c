@@ -0,0 +1,265 @@
+/*
+ * apex_script.c
+ * Contains the scriptable command interface of the simulator
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "apex_script.h"
+
+#define SCRIPT_LINE_SIZE 512
+
+/*
+This method prints the state reached after a run command
+*/
+static void
+script_print_status(const APEX_CPU *cpu, FILE *out)
+{
+    fprintf(out, "status cycle %d retired %d pc %d halted %d cosim_failed %d\n", cpu->clock,
+            cpu->insn_completed, cpu->thread->last_retired_pc, cpu->halt_cpu, cpu->cosim_failed);
+}
+
+/*
+This method prints the architectural registers and the condition flags
+*/
+static void
+script_print_regs(const APEX_CPU *cpu, FILE *out)
+{
+    for (int i = 0; i < REG_FILE_SIZE; i++)
+    {
+        fprintf(out, "reg R%d %d\n", i, cpu->thread->regs[i]);
+    }
+
+    fprintf(out, "flags Z %d P %d N %d\n", cpu->thread->zero_flag, cpu->thread->positive_flag, cpu->thread->negative_flag);
+}
+
+/*
+This method prints the run counters
+*/
+static void
+script_print_stats(const APEX_CPU *cpu, FILE *out)
+{
+    fprintf(out, "stat cycles %d\n", cpu->clock);
+    fprintf(out, "stat instructions %d\n", cpu->insn_completed);
+    fprintf(out, "stat cycles_skipped %lld\n", cpu->stats.cycles_skipped);
+    fprintf(out, "stat intFU_busy_cycles %lld\n", cpu->stats.intFU_busy_cycles);
+    fprintf(out, "stat addFU_busy_cycles %lld\n", cpu->stats.addFU_busy_cycles);
+    fprintf(out, "stat mulFU_busy_cycles %lld\n", cpu->stats.mulFU_busy_cycles);
+    fprintf(out, "stat divFU_busy_cycles %lld\n", cpu->stats.divFU_busy_cycles);
+    fprintf(out, "stat mem_busy_cycles %lld\n", cpu->stats.mem_busy_cycles);
+    fprintf(out, "stat dispatch_stall_cycles %lld\n", cpu->stats.dispatch_stall_cycles);
+    fprintf(out, "stat iq_full_stall_cycles %lld\n", cpu->stats.iq_full_stall_cycles);
+    fprintf(out, "stat rob_full_stall_cycles %lld\n", cpu->stats.rob_full_stall_cycles);
+    fprintf(out, "stat lsq_full_stall_cycles %lld\n", cpu->stats.lsq_full_stall_cycles);
+    fprintf(out, "stat free_list_stall_cycles %lld\n", cpu->stats.free_list_stall_cycles);
+    fprintf(out, "stat branches %lld\n", cpu->stats.branches);
+    fprintf(out, "stat branches_taken %lld\n", cpu->stats.branches_taken);
+    fprintf(out, "stat branch_stall_cycles %lld\n", cpu->stats.branch_stall_cycles);
+    fprintf(out, "stat branch_mispredicts %lld\n", cpu->stats.branch_mispredicts);
+    fprintf(out, "stat insns_squashed %lld\n", cpu->stats.insns_squashed);
+    fprintf(out, "stat regs_released_early %lld\n", cpu->stats.regs_released_early);
+    fprintf(out, "stat moves_eliminated %lld\n", cpu->stats.moves_eliminated);
+    fprintf(out, "stat consts_materialized %lld\n", cpu->stats.consts_materialized);
+    fprintf(out, "stat fused_pairs %lld\n", cpu->stats.fused_pairs);
+    fprintf(out, "stat loop_buffer_insns %lld\n", cpu->stats.loop_buffer_insns);
+    fprintf(out, "stat value_predictions %lld\n", cpu->stats.value_predictions);
+    fprintf(out, "stat value_mispredicts %lld\n", cpu->stats.value_mispredicts);
+    fprintf(out, "stat dcache_accesses %lld\n", cpu->stats.dcache_accesses);
+    fprintf(out, "stat dcache_misses %lld\n", cpu->stats.dcache_misses);
+    fprintf(out, "stat prefetches %lld\n", cpu->stats.prefetches);
+    fprintf(out, "stat prefetches_useful %lld\n", cpu->stats.prefetches_useful);
+    fprintf(out, "stat prefetches_late %lld\n", cpu->stats.prefetches_late);
+    fprintf(out, "stat ras_predictions %lld\n", cpu->stats.ras_predictions);
+    fprintf(out, "stat ras_correct %lld\n", cpu->stats.ras_correct);
+    fprintf(out, "stat itt_predictions %lld\n", cpu->stats.itt_predictions);
+    fprintf(out, "stat itt_correct %lld\n", cpu->stats.itt_correct);
+    fprintf(out, "stat indirect_unpredicted %lld\n", cpu->stats.indirect_unpredicted);
+}
+
+/*
+This method writes the architectural state to a file in the same records the commands print.
+Only non-zero memory words are written, pages never touched by the program are skipped.
+*/
+static int
+script_write_checkpoint(APEX_CPU *cpu, const char *filename)
+{
+    FILE *fp = fopen(filename, "w");
+
+    if (!fp)
+    {
+        return FALSE;
+    }
+
+    script_print_status(cpu, fp);
+    script_print_regs(cpu, fp);
+
+    for (int i = 0; i < DATA_MEMORY_PAGES; i++)
+    {
+        const int *page = cpu->data_memory.page_table[i];
+
+        if (!page)
+        {
+            continue;
+        }
+
+        for (int j = 0; j < DATA_MEMORY_PAGE_SIZE; j++)
+        {
+            if (page[j] != 0)
+            {
+                fprintf(fp, "mem %d %d\n", (i << DATA_MEMORY_PAGE_BITS) + j, page[j]);
+            }
+        }
+    }
+
+    return fclose(fp) == 0;
+}
+
+/*
+This method executes one command line. Returns FALSE and sets reason if the command failed.
+*/
+static int
+script_execute(APEX_CPU *cpu, const char *command, const char *args, FILE *out, const char **reason)
+{
+    if (strcmp(command, "run") == 0)
+    {
+        int cycles;
+
+        if (sscanf(args, "%d", &cycles) != 1 || cycles < 0)
+        {
+            *reason = "usage: run <cycles>";
+            return FALSE;
+        }
+
+        for (int i = 0; i < cycles; i++)
+        {
+            if (APEX_cpu_step(cpu))
+            {
+                break;
+            }
+        }
+
+        script_print_status(cpu, out);
+    }
+    else if (strcmp(command, "runto") == 0)
+    {
+        int pc;
+        int max_cycles = 0;
+        int retired;
+
+        if (sscanf(args, "%d %d", &pc, &max_cycles) < 1)
+        {
+            *reason = "usage: runto <pc> [<max cycles>]";
+            return FALSE;
+        }
+
+        for (int i = 0; max_cycles <= 0 || i < max_cycles; i++)
+        {
+            retired = cpu->insn_completed;
+            if (APEX_cpu_step(cpu) || (cpu->insn_completed != retired && cpu->thread->last_retired_pc == pc))
+            {
+                break;
+            }
+        }
+
+        script_print_status(cpu, out);
+    }
+    else if (strcmp(command, "regs") == 0)
+    {
+        script_print_regs(cpu, out);
+    }
+    else if (strcmp(command, "mem") == 0)
+    {
+        int address;
+        int count = 1;
+        int value;
+
+        if (sscanf(args, "%d %d", &address, &count) < 1 || count < 1)
+        {
+            *reason = "usage: mem <address> [<count>]";
+            return FALSE;
+        }
+
+        if (!data_memory_in_range(address) || count > DATA_MEMORY_SIZE - address)
+        {
+            *reason = "address out of range";
+            return FALSE;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            data_memory_read(&cpu->data_memory, address + i, &value);
+            fprintf(out, "mem %d %d\n", address + i, value);
+        }
+    }
+    else if (strcmp(command, "stats") == 0)
+    {
+        script_print_stats(cpu, out);
+    }
+    else if (strcmp(command, "checkpoint") == 0)
+    {
+        char filename[SCRIPT_LINE_SIZE];
+
+        if (sscanf(args, "%511s", filename) != 1)
+        {
+            *reason = "usage: checkpoint <file>";
+            return FALSE;
+        }
+
+        if (!script_write_checkpoint(cpu, filename))
+        {
+            *reason = "unable to write checkpoint file";
+            return FALSE;
+        }
+    }
+    else
+    {
+        *reason = "unknown command";
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*
+This method reads commands from in until end of input or quit and prints the replies to out.
+Returns the number of commands that failed.
+*/
+int
+apex_script_run(APEX_CPU *cpu, FILE *in, FILE *out)
+{
+    char line[SCRIPT_LINE_SIZE];
+    char command[32];
+    int consumed;
+    int failed = 0;
+
+    while (fgets(line, sizeof(line), in))
+    {
+        const char *reason = NULL;
+
+        if (sscanf(line, "%31s%n", command, &consumed) != 1 || command[0] == '#')
+        {
+            continue;
+        }
+
+        if (strcmp(command, "quit") == 0)
+        {
+            fprintf(out, "ok quit\n");
+            break;
+        }
+
+        if (script_execute(cpu, command, line + consumed, out, &reason))
+        {
+            fprintf(out, "ok %s\n", command);
+        }
+        else
+        {
+            fprintf(out, "error %s %s\n", command, reason);
+            failed++;
+        }
+
+        fflush(out);
+    }
+
+    return failed;
+}
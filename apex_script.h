@@ -0,0 +1,29 @@
+/*
+ * apex_script.h
+ * Contains the scriptable command interface of the simulator
+ *
+ * Commands are read one per line from a file or a pipe, blank lines and lines starting with '#'
+ * are skipped:
+ *
+ *   run <cycles>                 simulate the given number of cycles, or until HALT
+ *   runto <pc> [<max cycles>]    simulate until the instruction at pc retires, or until HALT
+ *   regs                         dump the architectural registers and flags
+ *   mem <address> [<count>]      dump count words of data memory starting at address
+ *   stats                        dump the run counters
+ *   checkpoint <file>            write the registers, flags and non-zero memory words to a file
+ *   quit                         stop reading commands
+ *
+ * Every output line is "<record> <fields...>" separated by single spaces. A command ends with
+ * "ok <command>" or "error <command> <reason>" so that a driver can read the replies of one
+ * command up to that line.
+ */
+#ifndef _APEX_SCRIPT_H_
+#define _APEX_SCRIPT_H_
+
+#include <stdio.h>
+
+#include "apex_cpu.h"
+
+int apex_script_run(APEX_CPU *cpu, FILE *in, FILE *out);
+
+#endif
@@ -0,0 +1,10 @@
+MOVC R1,#4032
+MOVC R2,#0
+MOVC R3,#10
+JALR R15,R1,#0
+SUBL R3,R3,#1
+BNZ #-8
+STORE R2,R1,#0
+HALT
+ADDL R2,R2,#5
+JUMP R15,#0
@@ -0,0 +1,17 @@
+MOVC R1,#0
+MOVC R2,#-1
+MOVC R3,#5
+MOVC R4,#0
+MOVC R10,#1000
+MUL R3,R3,R2
+ADD R4,R4,R3
+ADDL R1,R1,#1
+CML R1,#20
+BN #-16
+STORE R4,R10,#0
+MOVC R5,#10
+ADD R4,R4,R5
+SUBL R5,R5,#1
+BP #-8
+STORE R4,R10,#4
+HALT
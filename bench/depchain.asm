@@ -0,0 +1,51 @@
+MOVC R1,#1
+MOVC R2,#3
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+MUL R1,R1,R2
+ADDL R1,R1,#1
+ADDL R1,R1,#1
+HALT
@@ -0,0 +1,12 @@
+MOVC R1,#98765
+MOVC R2,#10
+MOVC R4,#0
+MOVC R10,#1000
+DIV R3,R1,R2
+MUL R5,R3,R2
+SUB R6,R1,R5
+ADD R4,R4,R6
+ADDL R1,R3,#0
+BNZ #-20
+STORE R4,R10,#0
+HALT
@@ -0,0 +1,13 @@
+MOVC R10,#1000
+MOVC R11,#2000
+MOVC R12,#3000
+MOVC R4,#64
+MOVC R5,#0
+LOADP R1,R10,#0
+LOADP R2,R11,#0
+MUL R3,R1,R2
+ADD R5,R5,R3
+SUBL R4,R4,#1
+BNZ #-20
+STORE R5,R12,#0
+HALT
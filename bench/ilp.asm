@@ -0,0 +1,64 @@
+MOVC R1,#1
+MOVC R2,#2
+MOVC R3,#3
+MOVC R4,#4
+MOVC R5,#5
+MOVC R6,#6
+MOVC R7,#7
+MOVC R8,#8
+ADDL R1,R1,#1
+ADDL R2,R2,#1
+ADDL R3,R3,#1
+ADDL R4,R4,#1
+ADDL R5,R5,#1
+ADDL R6,R6,#1
+ADDL R7,R7,#1
+ADDL R8,R8,#1
+ADDL R1,R1,#2
+ADDL R2,R2,#2
+ADDL R3,R3,#2
+ADDL R4,R4,#2
+ADDL R5,R5,#2
+ADDL R6,R6,#2
+ADDL R7,R7,#2
+ADDL R8,R8,#2
+ADDL R1,R1,#3
+ADDL R2,R2,#3
+ADDL R3,R3,#3
+ADDL R4,R4,#3
+ADDL R5,R5,#3
+ADDL R6,R6,#3
+ADDL R7,R7,#3
+ADDL R8,R8,#3
+ADDL R1,R1,#4
+ADDL R2,R2,#4
+ADDL R3,R3,#4
+ADDL R4,R4,#4
+ADDL R5,R5,#4
+ADDL R6,R6,#4
+ADDL R7,R7,#4
+ADDL R8,R8,#4
+ADDL R1,R1,#5
+ADDL R2,R2,#5
+ADDL R3,R3,#5
+ADDL R4,R4,#5
+ADDL R5,R5,#5
+ADDL R6,R6,#5
+ADDL R7,R7,#5
+ADDL R8,R8,#5
+ADDL R1,R1,#6
+ADDL R2,R2,#6
+ADDL R3,R3,#6
+ADDL R4,R4,#6
+ADDL R5,R5,#6
+ADDL R6,R6,#6
+ADDL R7,R7,#6
+ADDL R8,R8,#6
+ADD R9,R1,R2
+ADD R10,R3,R4
+ADD R11,R5,R6
+ADD R12,R7,R8
+ADD R9,R9,R10
+ADD R11,R11,R12
+ADD R9,R9,R11
+HALT
@@ -0,0 +1,23 @@
+MOVC R10,#1000
+MOVC R11,#1
+MOVC R12,#2000
+MOVC R1,#7
+STORE R1,R12,#0
+MOVC R15,#64
+STORE R11,R10,#0
+ADDL R11,R11,#3
+ADDL R10,R10,#4
+SUBL R15,R15,#1
+BNZ #-16
+MOVC R10,#1000
+MOVC R6,#0
+MOVC R15,#64
+LOAD R4,R12,#0
+LOAD R3,R10,#0
+MUL R5,R3,R4
+ADD R6,R6,R5
+ADDL R10,R10,#4
+SUBL R15,R15,#1
+BNZ #-24
+STORE R6,R12,#4
+HALT
@@ -0,0 +1,24 @@
+MOVC R10,#1000
+MOVC R12,#3000
+MOVC R6,#8
+MOVC R11,#2000
+MOVC R7,#8
+ADDL R13,R10,#0
+ADDL R14,R11,#0
+MOVC R5,#0
+MOVC R8,#8
+LOADP R1,R13,#0
+LOAD R2,R14,#0
+ADDL R14,R14,#32
+MUL R3,R1,R2
+ADD R5,R5,R3
+SUBL R8,R8,#1
+BNZ #-24
+STOREP R5,R12,#0
+ADDL R11,R11,#4
+SUBL R7,R7,#1
+BNZ #-56
+ADDL R10,R10,#32
+SUBL R6,R6,#1
+BNZ #-76
+HALT
@@ -0,0 +1,8 @@
+MOVC R10,#1000
+MOVC R11,#2000
+MOVC R4,#64
+LOADP R1,R10,#0
+STOREP R1,R11,#0
+SUBL R4,R4,#1
+BNZ #-12
+HALT
@@ -0,0 +1,14 @@
+MOVC R1,#30000
+MUL R1,R1,R1
+MOVC R2,#1
+MOVC R4,#100
+MOVC R10,#1000
+DIV R5,R1,R2
+ADDL R6,R5,#0
+OR R7,R6,R6
+ADDL R8,R7,#0
+AND R1,R8,R8
+SUBL R4,R4,#1
+BNZ #-24
+STORE R1,R10,#0
+HALT
@@ -0,0 +1,66 @@
+MOVC R1,#4880
+MOVC R2,#2324
+STORE R1,R2,#0
+MOVC R1,#1616
+MOVC R2,#4880
+STORE R1,R2,#0
+MOVC R1,#2616
+MOVC R2,#1616
+STORE R1,R2,#0
+MOVC R1,#3664
+MOVC R2,#2616
+STORE R1,R2,#0
+MOVC R1,#1196
+MOVC R2,#3664
+STORE R1,R2,#0
+MOVC R1,#1296
+MOVC R2,#1196
+STORE R1,R2,#0
+MOVC R1,#4360
+MOVC R2,#1296
+STORE R1,R2,#0
+MOVC R1,#3192
+MOVC R2,#4360
+STORE R1,R2,#0
+MOVC R1,#1384
+MOVC R2,#3192
+STORE R1,R2,#0
+MOVC R1,#2496
+MOVC R2,#1384
+STORE R1,R2,#0
+MOVC R1,#3384
+MOVC R2,#2496
+STORE R1,R2,#0
+MOVC R1,#1236
+MOVC R2,#3384
+STORE R1,R2,#0
+MOVC R1,#4724
+MOVC R2,#1236
+STORE R1,R2,#0
+MOVC R1,#3076
+MOVC R2,#4724
+STORE R1,R2,#0
+MOVC R1,#1876
+MOVC R2,#3076
+STORE R1,R2,#0
+MOVC R1,#0
+MOVC R2,#1876
+STORE R1,R2,#0
+MOVC R1,#2324
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+LOAD R1,R1,#0
+HALT
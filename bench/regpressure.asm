@@ -0,0 +1,25 @@
+MOVC R9,#30000
+MUL R9,R9,R9
+MOVC R12,#1
+MOVC R15,#12
+DIV R9,R9,R12
+DIV R9,R9,R12
+ADDL R1,R1,#1
+ADDL R2,R2,#1
+ADDL R3,R3,#1
+ADDL R4,R4,#1
+ADDL R5,R5,#1
+ADDL R6,R6,#1
+ADDL R7,R7,#1
+ADDL R8,R8,#1
+ADDL R1,R1,#2
+ADDL R2,R2,#2
+ADDL R3,R3,#2
+ADDL R4,R4,#2
+ADDL R5,R5,#2
+ADDL R6,R6,#2
+ADDL R7,R7,#2
+ADDL R8,R8,#2
+SUBL R15,R15,#1
+BNZ #-76
+HALT
@@ -0,0 +1,20 @@
+MOVC R1,#4096
+MOVC R2,#1
+MOVC R15,#256
+STOREP R2,R1,#0
+ADDL R2,R2,#3
+SUBL R15,R15,#1
+BNZ #-12
+MOVC R1,#4096
+MOVC R3,#12288
+MOVC R4,#5
+MOVC R6,#0
+MOVC R15,#256
+LOADP R5,R1,#0
+MUL R5,R5,R4
+ADD R6,R6,R5
+STOREP R5,R3,#0
+SUBL R15,R15,#1
+BNZ #-20
+STORE R6,R3,#0
+HALT
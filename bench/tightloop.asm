@@ -0,0 +1,11 @@
+MOVC R1,#0
+MOVC R2,#400
+MOVC R3,#0
+MOVC R10,#1000
+ADD R3,R3,R2
+ADDL R1,R1,#1
+SUBL R2,R2,#1
+BNZ #-12
+STORE R3,R10,#0
+STORE R1,R10,#4
+HALT
@@ -0,0 +1,11 @@
+MOVC R10,#1000
+MOVC R11,#2000
+MOVC R12,#3000
+MOVC R4,#64
+LOADP R1,R10,#0
+LOADP R2,R11,#0
+ADD R3,R1,R2
+STOREP R3,R12,#0
+SUBL R4,R4,#1
+BNZ #-20
+HALT
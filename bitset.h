@@ -0,0 +1,88 @@
+/*
+ * bitset.h
+ * Contains the fixed-size bitsets used for the dense scheduler state of the IQ and PRF
+ *
+ * A bitset of n bits is an array of BITSET_WORDS(n) 64-bit words, bit i lives in word i / 64.
+ */
+#ifndef _BITSET_H_
+#define _BITSET_H_
+
+#include <stdint.h>
+
+#define BITSET_WORDS(bits) (((bits) + 63) / 64)
+
+static inline int
+bitset_test(const uint64_t *set, int i)
+{
+    return (set[i >> 6] >> (i & 63)) & 1;
+}
+
+static inline void
+bitset_set(uint64_t *set, int i)
+{
+    set[i >> 6] |= 1ull << (i & 63);
+}
+
+static inline void
+bitset_clear(uint64_t *set, int i)
+{
+    set[i >> 6] &= ~(1ull << (i & 63));
+}
+
+static inline void
+bitset_assign(uint64_t *set, int i, int value)
+{
+    if (value)
+    {
+        bitset_set(set, i);
+    }
+    else
+    {
+        bitset_clear(set, i);
+    }
+}
+
+/*
+This method returns the number of set bits
+*/
+static inline int
+bitset_count(const uint64_t *set, int words)
+{
+    int count = 0;
+
+    for (int word = 0; word < words; word++)
+    {
+        count += __builtin_popcountll(set[word]);
+    }
+
+    return count;
+}
+
+/*
+This method returns the index of the lowest set bit at or after start, -1 if there is none
+*/
+static inline int
+bitset_next(const uint64_t *set, int words, int start)
+{
+    int word = start >> 6;
+    uint64_t bits;
+
+    if (word >= words)
+    {
+        return -1;
+    }
+
+    bits = set[word] & (~0ull << (start & 63));
+    while (!bits)
+    {
+        if (++word >= words)
+        {
+            return -1;
+        }
+        bits = set[word];
+    }
+
+    return (word << 6) + __builtin_ctzll(bits);
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * data_cache.c
+ * Contains the timing model of the data cache the loads and stores of the LSQ go through
+ */
+#include "data_cache.h"
+
+static int
+dcache_set(int address)
+{
+    return (address >> DCACHE_LINE_BITS) & (DCACHE_SETS - 1);
+}
+
+static int
+dcache_tag(int address)
+{
+    return address >> DCACHE_LINE_BITS;
+}
+
+/*
+This method returns the way of the set holding the line of address, -1 if it is not in the cache
+*/
+static int
+dcache_lookup(const Data_Cache *dc, int set, int tag)
+{
+    for (int way = 0; way < DCACHE_WAYS; way++)
+    {
+        if (dc->lines[set][way].valid && dc->lines[set][way].tag == tag)
+        {
+            return way;
+        }
+    }
+
+    return -1;
+}
+
+/*
+This method puts the line of address in the cache, in place of the least recently used line of its
+set, with its fill completing MEM_MISS_LATENCY cycles from now
+*/
+static Cache_Line *
+dcache_fill(Data_Cache *dc, int set, int tag, int now)
+{
+    Cache_Line *victim = &dc->lines[set][0];
+
+    for (int way = 1; way < DCACHE_WAYS && victim->valid; way++)
+    {
+        Cache_Line *line = &dc->lines[set][way];
+
+        if (!line->valid || line->last_used < victim->last_used)
+        {
+            victim = line;
+        }
+    }
+
+    victim->valid = TRUE;
+    victim->tag = tag;
+    victim->ready_cycle = now + MEM_MISS_LATENCY;
+    victim->last_used = now;
+    victim->prefetched = FALSE;
+
+    return victim;
+}
+
+void
+data_cache_init(Data_Cache *dc)
+{
+    for (int set = 0; set < DCACHE_SETS; set++)
+    {
+        for (int way = 0; way < DCACHE_WAYS; way++)
+        {
+            dc->lines[set][way].valid = FALSE;
+            dc->lines[set][way].prefetched = FALSE;
+        }
+    }
+}
+
+/*
+This method performs the timing of a demand access to address started in cycle now, and sets
+*latency to the cycles it takes. Returns DCACHE_HIT, DCACHE_MISS or DCACHE_PREFETCH_HIT.
+*/
+int
+data_cache_access(Data_Cache *dc, int address, int now, int *latency)
+{
+    int set = dcache_set(address);
+    int tag = dcache_tag(address);
+    int way = dcache_lookup(dc, set, tag);
+    Cache_Line *line;
+    int outcome = DCACHE_HIT;
+
+    if (way == -1)
+    {
+        dcache_fill(dc, set, tag, now);
+        *latency = MEM_MISS_LATENCY;
+        return DCACHE_MISS;
+    }
+
+    line = &dc->lines[set][way];
+    if (line->prefetched)
+    {
+        line->prefetched = FALSE;
+        outcome = DCACHE_PREFETCH_HIT;
+    }
+    line->last_used = now;
+
+    /* A line still being filled delivers its data when the fill completes */
+    *latency = MEM_ACCESS_LATENCY;
+    if (line->ready_cycle - now > *latency)
+    {
+        *latency = line->ready_cycle - now;
+    }
+
+    return outcome;
+}
+
+/*
+This method starts filling the line of address ahead of demand. Returns FALSE if the line is already
+in the cache or being filled, no prefetch is issued then.
+*/
+int
+data_cache_prefetch(Data_Cache *dc, int address, int now)
+{
+    int set = dcache_set(address);
+    int tag = dcache_tag(address);
+
+    if (dcache_lookup(dc, set, tag) != -1)
+    {
+        return FALSE;
+    }
+
+    dcache_fill(dc, set, tag, now)->prefetched = TRUE;
+    return TRUE;
+}
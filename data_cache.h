@@ -0,0 +1,46 @@
+/*
+ * data_cache.h
+ * Contains the timing model of the data cache the loads and stores of the LSQ go through
+ *
+ * The cache only keeps tags: the data always comes from the data memory, the cache decides how long
+ * an access takes. It is set associative with LRU replacement and allocates a line on every miss,
+ * stores included. A line records the cycle its fill from memory completes, so that an access to a
+ * line still being filled, by an earlier miss or by a prefetch, waits for the rest of the fill.
+ *
+ * A line covers DCACHE_LINE_SIZE consecutive addresses, e.g. four words at the stride of 4 of the
+ * LOADP/STOREP post-increment.
+ */
+#ifndef _DATA_CACHE_H_
+#define _DATA_CACHE_H_
+
+#include "apex_macros.h"
+
+#define DCACHE_LINE_BITS 4
+#define DCACHE_LINE_SIZE (1 << DCACHE_LINE_BITS)
+#define DCACHE_SETS 64                  /* Must be a power of two */
+#define DCACHE_WAYS 2
+
+/* Outcome of a demand access */
+#define DCACHE_HIT 0
+#define DCACHE_MISS 1
+#define DCACHE_PREFETCH_HIT 2           /* First demand access to a line brought in by a prefetch */
+
+typedef struct Cache_Line
+{
+    int valid;
+    int tag;
+    int ready_cycle;                    /* Cycle the fill of the line completes */
+    int last_used;                      /* Cycle of the latest access, for LRU */
+    int prefetched;                     /* Brought in by a prefetch and not accessed on demand yet */
+} Cache_Line;
+
+typedef struct Data_Cache
+{
+    Cache_Line lines[DCACHE_SETS][DCACHE_WAYS];
+} Data_Cache;
+
+void data_cache_init(Data_Cache *dc);
+int data_cache_access(Data_Cache *dc, int address, int now, int *latency);
+int data_cache_prefetch(Data_Cache *dc, int address, int now);
+
+#endif
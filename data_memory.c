@@ -0,0 +1,106 @@
+/*
+ * data_memory.c
+ * Contains the paged, sparse data memory used by the APEX cpu
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "data_memory.h"
+
+/*
+This method sets up an empty data memory. Only the page table is allocated here.
+*/
+int
+data_memory_init(Data_Memory *mem)
+{
+    mem->page_table = calloc(DATA_MEMORY_PAGES, sizeof(int *));
+    mem->pages_allocated = 0;
+    mem->last_page_num = -1;
+    mem->last_page = NULL;
+
+    return mem->page_table != NULL;
+}
+
+/*
+This method releases every page and the page table
+*/
+void
+data_memory_free(Data_Memory *mem)
+{
+    if (!mem->page_table)
+    {
+        return;
+    }
+
+    for (int i = 0; i < DATA_MEMORY_PAGES; i++)
+    {
+        free(mem->page_table[i]);
+    }
+
+    free(mem->page_table);
+    mem->page_table = NULL;
+    mem->pages_allocated = 0;
+    mem->last_page_num = -1;
+    mem->last_page = NULL;
+}
+
+/*
+This method makes dst a deep copy of src, only the allocated pages are copied.
+dst must not be initialized.
+*/
+int
+data_memory_copy(Data_Memory *dst, const Data_Memory *src)
+{
+    if (!data_memory_init(dst))
+    {
+        return FALSE;
+    }
+
+    for (int i = 0; i < DATA_MEMORY_PAGES; i++)
+    {
+        if (src->page_table[i])
+        {
+            dst->page_table[i] = malloc(DATA_MEMORY_PAGE_SIZE * sizeof(int));
+            if (!dst->page_table[i])
+            {
+                data_memory_free(dst);
+                return FALSE;
+            }
+
+            memcpy(dst->page_table[i], src->page_table[i], DATA_MEMORY_PAGE_SIZE * sizeof(int));
+            dst->pages_allocated++;
+        }
+    }
+
+    return TRUE;
+}
+
+/*
+This method is the slow path of a memory access: it walks the page table and, if requested,
+allocates a zeroed page. The page found becomes the fast-path page.
+*/
+int *
+data_memory_page_lookup(Data_Memory *mem, int page_num, int allocate)
+{
+    int *page = mem->page_table[page_num];
+
+    if (!page && allocate)
+    {
+        page = calloc(DATA_MEMORY_PAGE_SIZE, sizeof(int));
+        if (!page)
+        {
+            return NULL;
+        }
+
+        mem->page_table[page_num] = page;
+        mem->pages_allocated++;
+    }
+
+    if (page)
+    {
+        mem->last_page_num = page_num;
+        mem->last_page = page;
+    }
+
+    return page;
+}
@@ -0,0 +1,95 @@
+/*
+ * data_memory.h
+ * Contains the paged, sparse data memory used by the APEX cpu
+ *
+ * Pages are allocated lazily on the first write that touches them, so the
+ * cost of a CPU instance only grows with the part of the address space a
+ * program actually uses. Reads from untouched pages return zero.
+ */
+#ifndef _DATA_MEMORY_H_
+#define _DATA_MEMORY_H_
+
+#include "apex_macros.h"
+
+typedef struct Data_Memory
+{
+    int **page_table;       /* DATA_MEMORY_PAGES entries, NULL until touched */
+    int pages_allocated;    /* Number of pages backed by host memory */
+    int last_page_num;      /* Page number of the last touched page, -1 if none */
+    int *last_page;         /* Host pointer of the last touched page */
+} Data_Memory;
+
+int data_memory_init(Data_Memory *mem);
+void data_memory_free(Data_Memory *mem);
+int data_memory_copy(Data_Memory *dst, const Data_Memory *src);
+int *data_memory_page_lookup(Data_Memory *mem, int page_num, int allocate);
+
+/*
+This method returns TRUE if the address lies inside the data memory
+*/
+static inline int
+data_memory_in_range(int address)
+{
+    return address >= 0 && address < DATA_MEMORY_SIZE;
+}
+
+/*
+This method reads one word of data memory into value. Returns FALSE if the address is out of range.
+*/
+static inline int
+data_memory_read(Data_Memory *mem, int address, int *value)
+{
+    int page_num = address >> DATA_MEMORY_PAGE_BITS;
+    int *page;
+
+    if (!data_memory_in_range(address))
+    {
+        return FALSE;
+    }
+
+    if (page_num == mem->last_page_num)
+    {
+        page = mem->last_page;
+    }
+    else
+    {
+        page = data_memory_page_lookup(mem, page_num, FALSE);
+    }
+
+    *value = page ? page[address & (DATA_MEMORY_PAGE_SIZE - 1)] : 0;
+    return TRUE;
+}
+
+/*
+This method writes one word of data memory. Returns FALSE if the address is out of range or the page
+could not be allocated.
+*/
+static inline int
+data_memory_write(Data_Memory *mem, int address, int value)
+{
+    int page_num = address >> DATA_MEMORY_PAGE_BITS;
+    int *page;
+
+    if (!data_memory_in_range(address))
+    {
+        return FALSE;
+    }
+
+    if (page_num == mem->last_page_num)
+    {
+        page = mem->last_page;
+    }
+    else
+    {
+        page = data_memory_page_lookup(mem, page_num, TRUE);
+        if (!page)
+        {
+            return FALSE;
+        }
+    }
+
+    page[address & (DATA_MEMORY_PAGE_SIZE - 1)] = value;
+    return TRUE;
+}
+
+#endif
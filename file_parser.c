@@ -7,7 +7,6 @@
  * Copyright (c) 2020, Gaurav Kothari (gkothar1@binghamton.edu)
  * State University of New York at Binghamton
  */
-#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -176,25 +175,23 @@ set_opcode_str(const char *opcode_str)
         return OPCODE_CMP;
     }
 
-    printf("\n.%s.\n", opcode_str);
-    printf("\n.NOP.\n");
-    // printf("\n%d\n", strcmp(opcode_str, "NOP"));
-    assert(0 && "Invalid opcode");
-    return 0;
+    fprintf(stderr, "APEX_Error: Invalid opcode %s\n", opcode_str);
+    return -1;
 }
 
 static void
 split_opcode_from_insn_string(char *buffer, char tokens[2][128])
 {
     int token_num = 0;
+    char *save_ptr;
 
-    char *token = strtok(buffer, " ");
+    char *token = strtok_r(buffer, " ", &save_ptr);
 
     while (token != NULL)
     {
         strcpy(tokens[token_num], token);
         token_num++;
-        token = strtok(NULL, " ");
+        token = strtok_r(NULL, " ", &save_ptr);
     }
 }
 
@@ -209,6 +206,7 @@ create_APEX_instruction(APEX_Instruction *ins, char *buffer)
     int i, token_num = 0;
     char tokens[6][128];
     char top_level_tokens[2][128];
+    char *save_ptr;
 
     for (i = 0; i < 2; ++i)
     {
@@ -217,13 +215,13 @@ create_APEX_instruction(APEX_Instruction *ins, char *buffer)
 
     split_opcode_from_insn_string(buffer, top_level_tokens);
 
-    char *token = strtok(top_level_tokens[1], ",");
+    char *token = strtok_r(top_level_tokens[1], ",", &save_ptr);
 
     while (token != NULL)
     {
         strcpy(tokens[token_num], token);
         token_num++;
-        token = strtok(NULL, ",");
+        token = strtok_r(NULL, ",", &save_ptr);
     }
 
     strcpy(ins->opcode_str, top_level_tokens[0]);
@@ -288,12 +286,14 @@ create_APEX_instruction(APEX_Instruction *ins, char *buffer)
         {
             ins->rs1 = get_num_from_string(tokens[0]);
             ins->imm = get_num_from_string(tokens[1]);
+            break;
         }
 
         case OPCODE_CMP:
         {
             ins->rs1 = get_num_from_string(tokens[0]);
             ins->rs2 = get_num_from_string(tokens[1]);
+            break;
         }
 
         case OPCODE_MOVC:
@@ -358,6 +358,13 @@ create_code_memory(const char *filename, int *size)
     while ((nread = getline(&line, &len, fp)) != -1)
     {
         create_APEX_instruction(&code_memory[current_instruction], line);
+        if (code_memory[current_instruction].opcode == -1)
+        {
+            free(code_memory);
+            free(line);
+            fclose(fp);
+            return NULL;
+        }
         current_instruction++;
     }
 
@@ -0,0 +1,241 @@
+/*
+ * golden_model.c
+ * Contains the functional (ISA-level) APEX reference model used for lockstep co-simulation
+ */
+#include <string.h>
+
+#include "apex_cpu.h"
+#include "golden_model.h"
+
+/*
+This method sets up the reference model at the reset state of the CPU: PC 4000, zeroed registers and memory
+*/
+int
+golden_model_init(Golden_Model *gm, const APEX_Instruction *code_memory, int code_memory_size)
+{
+    memset(gm, 0, sizeof(Golden_Model));
+    gm->pc = 4000;
+    gm->code_memory = code_memory;
+    gm->code_memory_size = code_memory_size;
+
+    return data_memory_init(&gm->data_memory);
+}
+
+void
+golden_model_free(Golden_Model *gm)
+{
+    data_memory_free(&gm->data_memory);
+}
+
+/*
+This method sets the condition flags from the result of a flag-producing instruction
+*/
+static void
+set_flags(Golden_Model *gm, int result)
+{
+    gm->zero_flag = result == 0;
+    gm->positive_flag = result > 0;
+    gm->negative_flag = result < 0;
+}
+
+/*
+This method executes the instruction at the current PC and reports its effects. Returns FALSE and sets
+effects->error if the instruction could not be executed.
+*/
+int
+golden_model_step(Golden_Model *gm, Golden_Effects *effects)
+{
+    const APEX_Instruction *insn;
+    int index = (gm->pc - 4000) / 4;
+    int next_pc = gm->pc + 4;
+    int result = 0;
+    int value;
+
+    memset(effects, 0, sizeof(Golden_Effects));
+    effects->pc = gm->pc;
+    effects->opcode = -1;
+
+    if (gm->halted || gm->pc < 4000 || (gm->pc - 4000) % 4 != 0 || index >= gm->code_memory_size)
+    {
+        effects->error = GOLDEN_ERROR_BAD_PC;
+        return FALSE;
+    }
+
+    insn = &gm->code_memory[index];
+    effects->opcode = insn->opcode;
+
+    switch (insn->opcode)
+    {
+        case OPCODE_ADD:
+        case OPCODE_SUB:
+        case OPCODE_MUL:
+        case OPCODE_DIV:
+        {
+            int a = gm->regs[insn->rs1];
+            int b = gm->regs[insn->rs2];
+
+            if (insn->opcode == OPCODE_ADD)
+            {
+                result = a + b;
+            }
+            else if (insn->opcode == OPCODE_SUB)
+            {
+                result = a - b;
+            }
+            else if (insn->opcode == OPCODE_MUL)
+            {
+                result = a * b;
+            }
+            else
+            {
+                if (b == 0)
+                {
+                    effects->error = GOLDEN_ERROR_DIV_BY_ZERO;
+                    return FALSE;
+                }
+                /* INT_MIN / -1 wraps instead of trapping on the host */
+                result = b == -1 ? (int)(0u - (unsigned int)a) : a / b;
+            }
+
+            gm->regs[insn->rd] = result;
+            set_flags(gm, result);
+            break;
+        }
+
+        case OPCODE_ADDL:
+        case OPCODE_SUBL:
+        {
+            result = insn->opcode == OPCODE_ADDL ? gm->regs[insn->rs1] + insn->imm
+                                                 : gm->regs[insn->rs1] - insn->imm;
+            gm->regs[insn->rd] = result;
+            set_flags(gm, result);
+            break;
+        }
+
+        case OPCODE_AND:
+        {
+            gm->regs[insn->rd] = gm->regs[insn->rs1] & gm->regs[insn->rs2];
+            break;
+        }
+
+        case OPCODE_OR:
+        {
+            gm->regs[insn->rd] = gm->regs[insn->rs1] | gm->regs[insn->rs2];
+            break;
+        }
+
+        case OPCODE_XOR:
+        {
+            gm->regs[insn->rd] = gm->regs[insn->rs1] ^ gm->regs[insn->rs2];
+            break;
+        }
+
+        case OPCODE_MOVC:
+        {
+            gm->regs[insn->rd] = insn->imm;
+            break;
+        }
+
+        case OPCODE_CMP:
+        {
+            set_flags(gm, gm->regs[insn->rs1] - gm->regs[insn->rs2]);
+            break;
+        }
+
+        case OPCODE_CML:
+        {
+            set_flags(gm, gm->regs[insn->rs1] - insn->imm);
+            break;
+        }
+
+        case OPCODE_LOAD:
+        case OPCODE_LOADP:
+        {
+            int base = gm->regs[insn->rs1];
+
+            if (!data_memory_read(&gm->data_memory, base + insn->imm, &value))
+            {
+                effects->error = GOLDEN_ERROR_MEMORY;
+                return FALSE;
+            }
+
+            gm->regs[insn->rd] = value;
+            if (insn->opcode == OPCODE_LOADP)
+            {
+                gm->regs[insn->rs1] = base + 4;
+            }
+            break;
+        }
+
+        case OPCODE_STORE:
+        case OPCODE_STOREP:
+        {
+            int base = gm->regs[insn->rs2];
+
+            effects->mem_written = TRUE;
+            effects->mem_address = base + insn->imm;
+            effects->mem_value = gm->regs[insn->rs1];
+
+            if (!data_memory_write(&gm->data_memory, effects->mem_address, effects->mem_value))
+            {
+                effects->error = GOLDEN_ERROR_MEMORY;
+                return FALSE;
+            }
+
+            if (insn->opcode == OPCODE_STOREP)
+            {
+                gm->regs[insn->rs2] = base + 4;
+            }
+            break;
+        }
+
+        case OPCODE_BZ:
+        case OPCODE_BNZ:
+        case OPCODE_BP:
+        case OPCODE_BNP:
+        case OPCODE_BN:
+        case OPCODE_BNN:
+        {
+            int taken = (insn->opcode == OPCODE_BZ && gm->zero_flag) ||
+                        (insn->opcode == OPCODE_BNZ && !gm->zero_flag) ||
+                        (insn->opcode == OPCODE_BP && gm->positive_flag) ||
+                        (insn->opcode == OPCODE_BNP && !gm->positive_flag) ||
+                        (insn->opcode == OPCODE_BN && gm->negative_flag) ||
+                        (insn->opcode == OPCODE_BNN && !gm->negative_flag);
+
+            if (taken)
+            {
+                next_pc = gm->pc + insn->imm;
+            }
+            break;
+        }
+
+        case OPCODE_JUMP:
+        {
+            next_pc = gm->regs[insn->rs1] + insn->imm;
+            break;
+        }
+
+        case OPCODE_JALR:
+        {
+            next_pc = gm->regs[insn->rs1] + insn->imm;
+            gm->regs[insn->rd] = gm->pc + 4;
+            break;
+        }
+
+        case OPCODE_HALT:
+        {
+            gm->halted = TRUE;
+            break;
+        }
+
+        case OPCODE_NOP:
+        default:
+            break;
+    }
+
+    gm->pc = next_pc;
+    gm->insn_executed++;
+
+    return TRUE;
+}
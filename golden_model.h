@@ -0,0 +1,46 @@
+/*
+ * golden_model.h
+ * Contains the functional (ISA-level) APEX reference model used for lockstep co-simulation
+ *
+ * The reference model executes one instruction per call to golden_model_step() with no
+ * notion of timing. The pipeline steps it once per retired instruction and compares the
+ * architectural effects of the two.
+ */
+#ifndef _GOLDEN_MODEL_H_
+#define _GOLDEN_MODEL_H_
+
+#include "apex_macros.h"
+#include "data_memory.h"
+
+struct APEX_Instruction;
+
+/* Architectural effects of one reference step */
+typedef struct Golden_Effects
+{
+    int pc;             /* PC of the instruction that was executed */
+    int opcode;
+    int mem_written;    /* TRUE if the instruction stored to memory */
+    int mem_address;
+    int mem_value;
+    int error;          /* GOLDEN_ERROR_* */
+} Golden_Effects;
+
+typedef struct Golden_Model
+{
+    int pc;
+    int regs[REG_FILE_SIZE];
+    int zero_flag;
+    int positive_flag;
+    int negative_flag;
+    int halted;
+    long long insn_executed;
+    Data_Memory data_memory;
+    const struct APEX_Instruction *code_memory;
+    int code_memory_size;
+} Golden_Model;
+
+int golden_model_init(Golden_Model *gm, const struct APEX_Instruction *code_memory, int code_memory_size);
+void golden_model_free(Golden_Model *gm);
+int golden_model_step(Golden_Model *gm, Golden_Effects *effects);
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * host_profile.h
+ * Contains the host-side timers used to find out where the simulator itself spends its time
+ *
+ * Each stage of the pipeline model is charged the host ticks elapsed since the previous lap.
+ * With ENABLE_HOST_PROFILING set to 0 every macro below expands to nothing.
+ */
+#ifndef _HOST_PROFILE_H_
+#define _HOST_PROFILE_H_
+
+#include "apex_macros.h"
+
+/* Simulator stages host time is charged to */
+#define PROF_FETCH 0
+#define PROF_DECODE 1
+#define PROF_DISPATCH 2
+#define PROF_GODZILLA_ALLOCATE 3
+#define PROF_GODZILLA_WAKEUP 4
+#define PROF_GODZILLA_ISSUE 5
+#define PROF_GODZILLA_COMMIT 6
+#define PROF_GODZILLA_LSQ 7
+#define PROF_EXECUTE 8
+#define PROF_OTHER 9
+#define PROF_STAGES 10
+
+#if ENABLE_HOST_PROFILING
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+typedef struct Host_Profile
+{
+    uint64_t ticks[PROF_STAGES];
+    uint64_t mark;      /* Counter value at the previous lap */
+} Host_Profile;
+
+/*
+This method reads the host cycle counter, or a nanosecond clock where there is none
+*/
+static inline uint64_t
+host_profile_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+#endif
+}
+
+#define HOST_PROFILE_START(cpu) ((cpu)->host_profile.mark = host_profile_now())
+#define HOST_PROFILE_LAP(cpu, stage)                                         \
+    do                                                                       \
+    {                                                                        \
+        uint64_t _lap_now = host_profile_now();                              \
+        (cpu)->host_profile.ticks[stage] += _lap_now - (cpu)->host_profile.mark; \
+        (cpu)->host_profile.mark = _lap_now;                                 \
+    } while (0)
+
+#else
+
+#define HOST_PROFILE_START(cpu)
+#define HOST_PROFILE_LAP(cpu, stage)
+
+#endif
+
+#endif
@@ -0,0 +1,445 @@
+/*
+ * job_server.c
+ * Contains the batch job server, which simulates many programs on a pool of worker threads
+ */
+#define _GNU_SOURCE
+#include <dirent.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "apex_cpu.h"
+#include "job_server.h"
+
+/* Jobs shared by the workers, each worker claims the next unclaimed one */
+typedef struct Job_Queue
+{
+    Job *jobs;
+    int count;
+    int next;
+    int cycles_limit;
+} Job_Queue;
+
+static const char *job_status_names[] = {
+    "ok", "init-failed", "mem-error", "cosim-failed", "cycle-limit", "div-by-zero"
+};
+
+/*
+This method appends an empty job to the list, growing it as needed. Returns NULL if out of memory.
+*/
+static Job *
+append_job(Job **jobs, int *count, int *capacity)
+{
+    if (*count == *capacity)
+    {
+        int new_capacity = *capacity ? *capacity * 2 : 16;
+        Job *grown = realloc(*jobs, new_capacity * sizeof(Job));
+
+        if (!grown)
+        {
+            return NULL;
+        }
+
+        *jobs = grown;
+        *capacity = new_capacity;
+    }
+
+    memset(&(*jobs)[*count], 0, sizeof(Job));
+    return &(*jobs)[(*count)++];
+}
+
+static int
+is_regular_file(const char *path)
+{
+    struct stat st;
+
+    return stat(path, &st) == 0 && S_ISREG(st.st_mode);
+}
+
+static int
+is_asm_file(const struct dirent *entry)
+{
+    const char *extension = strrchr(entry->d_name, '.');
+
+    return extension && strcmp(extension, ".asm") == 0;
+}
+
+/*
+This method makes a job of every program of a directory, in name order. A data memory image with
+the name of the program and a .hex or .bin extension is picked up if present.
+*/
+static int
+load_directory(const char *dir, Job **jobs, int *count)
+{
+    struct dirent **names;
+    int capacity = 0;
+    int n = scandir(dir, &names, is_asm_file, alphasort);
+
+    if (n < 0)
+    {
+        return FALSE;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        Job *job = append_job(jobs, count, &capacity);
+        int stem = (int)strlen(names[i]->d_name) - 4;
+
+        if (!job)
+        {
+            for (; i < n; i++)
+            {
+                free(names[i]);
+            }
+            free(names);
+            return FALSE;
+        }
+
+        snprintf(job->program, sizeof(job->program), "%s/%s", dir, names[i]->d_name);
+
+        snprintf(job->image, sizeof(job->image), "%s/%.*s.hex", dir, stem, names[i]->d_name);
+        if (!is_regular_file(job->image))
+        {
+            snprintf(job->image, sizeof(job->image), "%s/%.*s.bin", dir, stem, names[i]->d_name);
+            if (!is_regular_file(job->image))
+            {
+                job->image[0] = '\0';
+            }
+        }
+
+        free(names[i]);
+    }
+
+    free(names);
+    return TRUE;
+}
+
+/*
+This method resolves a path of the manifest against the directory of the manifest
+*/
+static void
+resolve_path(char *dst, const char *manifest_dir, const char *path)
+{
+    if (path[0] == '/' || !manifest_dir[0])
+    {
+        snprintf(dst, PATH_MAX, "%s", path);
+    }
+    else
+    {
+        snprintf(dst, PATH_MAX, "%s/%s", manifest_dir, path);
+    }
+}
+
+/*
+This method makes a job of every line of a manifest
+*/
+static int
+load_manifest(const char *manifest, Job **jobs, int *count)
+{
+    char manifest_dir[PATH_MAX];
+    char program[PATH_MAX];
+    char image[PATH_MAX];
+    char *line = NULL;
+    char *slash;
+    size_t line_size = 0;
+    int capacity = 0;
+    int status = TRUE;
+    FILE *fp = fopen(manifest, "r");
+
+    if (!fp)
+    {
+        return FALSE;
+    }
+
+    snprintf(manifest_dir, sizeof(manifest_dir), "%s", manifest);
+    slash = strrchr(manifest_dir, '/');
+    if (slash)
+    {
+        *slash = '\0';
+    }
+    else
+    {
+        manifest_dir[0] = '\0';
+    }
+
+    while (status && getline(&line, &line_size, fp) != -1)
+    {
+        int fields = sscanf(line, "%4095s %4095s", program, image);
+        Job *job;
+
+        if (fields < 1 || program[0] == '#')
+        {
+            continue;
+        }
+
+        job = append_job(jobs, count, &capacity);
+        if (!job)
+        {
+            status = FALSE;
+            break;
+        }
+
+        resolve_path(job->program, manifest_dir, program);
+
+        if (fields == 2)
+        {
+            char *at = strrchr(image, '@');
+
+            if (at)
+            {
+                *at = '\0';
+                job->image_base = atoi(at + 1);
+            }
+            resolve_path(job->image, manifest_dir, image);
+        }
+    }
+
+    free(line);
+    fclose(fp);
+
+    return status;
+}
+
+/*
+This method simulates one job on a CPU of its own until it halts or hits the cycle limit
+*/
+static void
+run_job(Job *job, int cycles_limit)
+{
+    struct timespec start, end;
+    APEX_CPU *cpu;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    cpu = APEX_cpu_init(job->program);
+    if (!cpu)
+    {
+        fprintf(stderr, "APEX_Error: Unable to initialize CPU for %s\n", job->program);
+        job->status = JOB_INIT_FAILED;
+        return;
+    }
+
+    if (job->image[0] && !APEX_cpu_load_memory_image(cpu, job->image, job->image_base))
+    {
+        job->status = JOB_INIT_FAILED;
+        APEX_cpu_stop(cpu);
+        return;
+    }
+
+    cpu->single_step = FALSE;
+    cpu->debug_messages = FALSE;
+
+    while (cpu->clock < cycles_limit)
+    {
+        if (APEX_cpu_step(cpu))
+        {
+            break;
+        }
+    }
+
+    if (cpu->cosim_failed)
+    {
+        job->status = JOB_COSIM_FAILED;
+    }
+    else if (cpu->halt_cpu && cpu->thread->cpu_rob[cpu->thread->rob_head].mem_error_codes == MEM_ERROR_DIV_BY_ZERO)
+    {
+        job->status = JOB_DIV_BY_ZERO;
+    }
+    else if (cpu->halt_cpu && !cpu->execute.is_halt_insn)
+    {
+        job->status = JOB_MEM_ERROR;
+    }
+    else if (!cpu->halt_cpu)
+    {
+        job->status = JOB_CYCLE_LIMIT_HIT;
+    }
+    else
+    {
+        job->status = JOB_OK;
+    }
+
+    job->cycles = cpu->clock;
+    job->insn_completed = cpu->insn_completed;
+
+    APEX_cpu_stop(cpu);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    job->host_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+}
+
+static void *
+job_worker(void *arg)
+{
+    Job_Queue *queue = arg;
+    int i;
+
+    while ((i = __atomic_fetch_add(&queue->next, 1, __ATOMIC_RELAXED)) < queue->count)
+    {
+        run_job(&queue->jobs[i], queue->cycles_limit);
+    }
+
+    return NULL;
+}
+
+/*
+This method prints a string as a JSON string literal
+*/
+static void
+print_json_string(FILE *fp, const char *s)
+{
+    fputc('"', fp);
+    for (; *s; s++)
+    {
+        if (*s == '"' || *s == '\\')
+        {
+            fputc('\\', fp);
+        }
+        fputc(*s, fp);
+    }
+    fputc('"', fp);
+}
+
+/*
+This method writes one record per job, in job order, as CSV or as a JSON array
+*/
+static void
+write_report(FILE *fp, const Job *jobs, int count, int json)
+{
+    if (json)
+    {
+        fprintf(fp, "[\n");
+    }
+    else
+    {
+        fprintf(fp, "program,image,status,cycles,instructions,ipc,host_ms\n");
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        const Job *job = &jobs[i];
+        double ipc = job->cycles ? (double)job->insn_completed / job->cycles : 0.0;
+
+        if (json)
+        {
+            fprintf(fp, "  {\"program\": ");
+            print_json_string(fp, job->program);
+            fprintf(fp, ", \"image\": ");
+            print_json_string(fp, job->image);
+            fprintf(fp, ", \"status\": \"%s\", \"cycles\": %d, \"instructions\": %d, \"ipc\": %.3f, \"host_ms\": %.3f}%s\n",
+                    job_status_names[job->status], job->cycles, job->insn_completed, ipc, job->host_ms,
+                    i == count - 1 ? "" : ",");
+        }
+        else
+        {
+            fprintf(fp, "%s,%s,%s,%d,%d,%.3f,%.3f\n", job->program, job->image, job_status_names[job->status],
+                    job->cycles, job->insn_completed, ipc, job->host_ms);
+        }
+    }
+
+    if (json)
+    {
+        fprintf(fp, "]\n");
+    }
+}
+
+/*
+This method runs every job found at path on the given number of worker threads and writes the
+report to report_file, to stdout if it is NULL or "-". A report file ending in .json is written as
+JSON, any other as CSV. Returns the number of jobs that failed, -1 if the batch could not run.
+*/
+int
+job_server_run(const char *path, int workers, const char *report_file, int cycles_limit)
+{
+    struct stat st;
+    struct timespec start, end;
+    Job_Queue queue = {0};
+    pthread_t *threads;
+    int started = 0;
+    int failed = 0;
+    int loaded;
+    FILE *report = stdout;
+    const char *extension;
+
+    if (stat(path, &st) != 0)
+    {
+        fprintf(stderr, "APEX_Error: Unable to find jobs at %s\n", path);
+        return -1;
+    }
+
+    loaded = S_ISDIR(st.st_mode) ? load_directory(path, &queue.jobs, &queue.count)
+                                 : load_manifest(path, &queue.jobs, &queue.count);
+    if (!loaded || queue.count == 0)
+    {
+        fprintf(stderr, "APEX_Error: No jobs could be read from %s\n", path);
+        free(queue.jobs);
+        return -1;
+    }
+
+    queue.cycles_limit = cycles_limit > 0 ? cycles_limit : JOB_CYCLE_LIMIT;
+    if (workers < 1)
+    {
+        workers = 1;
+    }
+    if (workers > queue.count)
+    {
+        workers = queue.count;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    /* The calling thread is a worker too, and takes over whatever a pool that failed to start leaves */
+    threads = calloc(workers, sizeof(pthread_t));
+    for (int i = 0; threads && i < workers - 1; i++)
+    {
+        if (pthread_create(&threads[i], NULL, job_worker, &queue) != 0)
+        {
+            break;
+        }
+        started++;
+    }
+
+    job_worker(&queue);
+
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (report_file && strcmp(report_file, "-") != 0)
+    {
+        report = fopen(report_file, "w");
+        if (!report)
+        {
+            fprintf(stderr, "APEX_Error: Unable to write report %s\n", report_file);
+            report = stdout;
+        }
+    }
+
+    extension = report != stdout ? strrchr(report_file, '.') : NULL;
+    write_report(report, queue.jobs, queue.count, extension && strcmp(extension, ".json") == 0);
+
+    if (report != stdout)
+    {
+        fclose(report);
+    }
+
+    for (int i = 0; i < queue.count; i++)
+    {
+        if (queue.jobs[i].status != JOB_OK)
+        {
+            failed++;
+        }
+    }
+
+    fprintf(stderr, "APEX_Server: %d jobs, %d failed, %.3f s on %d workers\n", queue.count, failed,
+            (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9, started + 1);
+
+    free(queue.jobs);
+    return failed;
+}
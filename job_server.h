@@ -0,0 +1,43 @@
+/*
+ * job_server.h
+ * Contains the batch job server, which simulates many programs on a pool of worker threads
+ *
+ * The jobs come either from a directory, where every "*.asm" file is a job and a "<name>.hex" or
+ * "<name>.bin" next to it is preloaded as its data memory image, or from a manifest with one job
+ * per line: "<program> [<image>[@<base>]]". Relative paths of a manifest are taken from the
+ * directory of the manifest, blank lines and lines starting with '#' are skipped.
+ *
+ * Every worker owns the APEX_CPU it is simulating, nothing is shared between workers but the index
+ * of the next job. A program that fails, or that has not halted after the cycle limit, is recorded
+ * in the report and the batch goes on.
+ */
+#ifndef _JOB_SERVER_H_
+#define _JOB_SERVER_H_
+
+#include <limits.h>
+
+/* Cycles a job may run before it is reported as hung */
+#define JOB_CYCLE_LIMIT 1000000
+
+/* Outcome of a job */
+#define JOB_OK 0
+#define JOB_INIT_FAILED 1
+#define JOB_MEM_ERROR 2
+#define JOB_COSIM_FAILED 3
+#define JOB_CYCLE_LIMIT_HIT 4
+#define JOB_DIV_BY_ZERO 5
+
+typedef struct Job
+{
+    char program[PATH_MAX];
+    char image[PATH_MAX];   /* Empty if the job has no data memory image */
+    int image_base;
+    int status;             /* JOB_* */
+    int cycles;
+    int insn_completed;
+    double host_ms;
+} Job;
+
+int job_server_run(const char *path, int workers, const char *report_file, int cycles_limit);
+
+#endif
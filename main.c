@@ -9,8 +9,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "apex_cpu.h"
+#include "apex_script.h"
+#include "job_server.h"
+#include "multicore.h"
+#include "memory_image.h"
 
 /*
  * This function is related to parsing input file
@@ -35,18 +41,548 @@ get_num_from_string(const char buffer[])
     return atoi(str);
 }
 
+/* Data memory image and trace options, given anywhere on the command line */
+typedef struct Memory_Options
+{
+    const char *load_file;      /* --load-mem <file>[@<base>] */
+    int load_base;
+    const char *dump_file;      /* --dump-mem <file>[@<start>[:<count>]] */
+    int dump_start;
+    int dump_count;
+    const char *pipeview_file;  /* --pipeview <file> */
+    const char *sample_file;    /* --sample <file>[@<interval>] */
+    int sample_interval;
+} Memory_Options;
+
+/*
+ * This function splits "<file>[@<address>[:<count>]]" into its parts. The file name is copied to
+ * storage owned by the options and lives until the program exits.
+ */
+static int
+parse_memory_option(const char *arg, const char **file, int *address, int *count)
+{
+    char *copy = strdup(arg);
+    char *at;
+
+    if (!copy)
+    {
+        return FALSE;
+    }
+
+    *address = 0;
+    at = strrchr(copy, '@');
+    if (at)
+    {
+        *at = '\0';
+        if (sscanf(at + 1, "%d:%d", address, count) < 1)
+        {
+            free(copy);
+            return FALSE;
+        }
+    }
+
+    *file = copy;
+    return copy[0] != '\0';
+}
+
+/*
+ * This function removes the memory image and trace options from the argument list, the remaining arguments
+ * keep their order. Returns FALSE on a malformed option.
+ */
+static int
+parse_memory_options(int *argc, const char *argv[], Memory_Options *options)
+{
+    int kept = 1;
+    int unused;
+
+    memset(options, 0, sizeof(Memory_Options));
+
+    for (int i = 1; i < *argc; i++)
+    {
+        if (strcmp(argv[i], "--load-mem") == 0 && i + 1 < *argc)
+        {
+            if (!parse_memory_option(argv[++i], &options->load_file, &options->load_base, &unused))
+            {
+                return FALSE;
+            }
+        }
+        else if (strcmp(argv[i], "--dump-mem") == 0 && i + 1 < *argc)
+        {
+            if (!parse_memory_option(argv[++i], &options->dump_file, &options->dump_start, &options->dump_count))
+            {
+                return FALSE;
+            }
+        }
+        else if (strcmp(argv[i], "--pipeview") == 0 && i + 1 < *argc)
+        {
+            options->pipeview_file = argv[++i];
+        }
+        else if (strcmp(argv[i], "--sample") == 0 && i + 1 < *argc)
+        {
+            if (!parse_memory_option(argv[++i], &options->sample_file, &options->sample_interval, &unused))
+            {
+                return FALSE;
+            }
+        }
+        else
+        {
+            argv[kept++] = argv[i];
+        }
+    }
+
+    *argc = kept;
+    return TRUE;
+}
+
+/*
+ * This function creates the CPU and applies the memory image and trace options to it
+ */
+static APEX_CPU *
+init_cpu(const char *filename, const Memory_Options *options)
+{
+    APEX_CPU *cpu = APEX_cpu_init(filename);
+
+    if (!cpu)
+    {
+        fprintf(stderr, "APEX_Error: Unable to initialize CPU\n");
+        return NULL;
+    }
+
+    if (options->load_file && !APEX_cpu_load_memory_image(cpu, options->load_file, options->load_base))
+    {
+        APEX_cpu_stop(cpu);
+        return NULL;
+    }
+
+    if (options->pipeview_file && !APEX_cpu_trace_pipeview(cpu, options->pipeview_file))
+    {
+        APEX_cpu_stop(cpu);
+        return NULL;
+    }
+
+    if (options->sample_file && !APEX_cpu_sample_stats(cpu, options->sample_file, options->sample_interval))
+    {
+        APEX_cpu_stop(cpu);
+        return NULL;
+    }
+
+    cpu->mem_dump_file = options->dump_file;
+    cpu->mem_dump_start = options->dump_start;
+    cpu->mem_dump_count = options->dump_count;
+
+    return cpu;
+}
+
+/*
+ * This function runs a program to completion without user interaction and reports the simulated
+ * cycles, the IPC and the simulator speed in simulated cycles per host second
+ */
+static int
+run_batch(const char *filename, int cycles_limit, const Memory_Options *options)
+{
+    APEX_CPU *cpu;
+    const char *kernel_name;
+    struct timespec start, end;
+    double host_seconds;
+    int status;
+
+    cpu = init_cpu(filename, options);
+    if (!cpu)
+    {
+        return 1;
+    }
+
+    cpu->single_step = FALSE;
+    cpu->debug_messages = FALSE;
+    cpu->cycles_limit = cycles_limit;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    APEX_cpu_run(cpu);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    host_seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    kernel_name = strrchr(filename, '/') ? strrchr(filename, '/') + 1 : filename;
+    printf("%-16s cycles %9d  insns %9d  IPC %6.3f  host %9.3f ms  %12.0f cycles/s%s\n",
+           kernel_name, cpu->clock, cpu->insn_completed,
+           cpu->clock ? (double)cpu->insn_completed / cpu->clock : 0.0,
+           host_seconds * 1e3, host_seconds > 0 ? cpu->clock / host_seconds : 0.0,
+           cpu->cosim_failed ? "  COSIM-FAIL" : (cpu->halt_cpu ? "" : "  CYCLE-LIMIT"));
+
+    status = cpu->cosim_failed ? 1 : 0;
+    APEX_cpu_stop(cpu);
+
+    return status;
+}
+
+/*
+ * This function drives the CPU from a command script, read from the given file or from stdin
+ */
+static int
+run_script(const char *filename, const char *script_filename, const Memory_Options *options)
+{
+    APEX_CPU *cpu;
+    FILE *script = stdin;
+    int failed;
+
+    if (script_filename && strcmp(script_filename, "-") != 0)
+    {
+        script = fopen(script_filename, "r");
+        if (!script)
+        {
+            fprintf(stderr, "APEX_Error: Unable to open command script %s\n", script_filename);
+            return 1;
+        }
+    }
+
+    cpu = init_cpu(filename, options);
+    if (!cpu)
+    {
+        if (script != stdin)
+        {
+            fclose(script);
+        }
+        return 1;
+    }
+
+    cpu->single_step = FALSE;
+    cpu->debug_messages = FALSE;
+
+    failed = apex_script_run(cpu, script, stdout);
+
+    if (script != stdin)
+    {
+        fclose(script);
+    }
+    APEX_cpu_stop(cpu);
+
+    return failed ? 1 : 0;
+}
+
+/*
+ * This function creates the cores of a multi-core run from "<program>[@<entry_pc>],...", a program
+ * listed twice runs on two cores. The memory image is loaded into every core, the pipeline trace and
+ * the interval statistics follow core 0. Returns the number of cores, 0 if one could not be created.
+ */
+static int
+init_cores(const char *core_list, const Memory_Options *options, APEX_CPU *cores[])
+{
+    Memory_Options core_options = *options;
+    char *list = strdup(core_list);
+    char *saveptr = NULL;
+    int count = 0;
+    int failed = !list;
+
+    /* The shared memory is dumped once every core has finished */
+    core_options.dump_file = NULL;
+
+    for (char *spec = list ? strtok_r(list, ",", &saveptr) : NULL; spec && !failed;
+         spec = strtok_r(NULL, ",", &saveptr))
+    {
+        char *at = strrchr(spec, '@');
+
+        if (count == MULTICORE_MAX_CORES)
+        {
+            fprintf(stderr, "APEX_Error: At most %d cores can be simulated\n", MULTICORE_MAX_CORES);
+            failed = TRUE;
+            break;
+        }
+
+        if (at)
+        {
+            *at = '\0';
+        }
+
+        cores[count] = init_cpu(spec, &core_options);
+        if (!cores[count])
+        {
+            failed = TRUE;
+            break;
+        }
+        count++;
+
+        cores[count - 1]->single_step = FALSE;
+        cores[count - 1]->debug_messages = FALSE;
+        failed = at && !APEX_cpu_set_entry_pc(cores[count - 1], get_num_from_string(at + 1));
+
+        core_options.pipeview_file = NULL;
+        core_options.sample_file = NULL;
+    }
+
+    free(list);
+
+    if (failed)
+    {
+        for (int c = 0; c < count; c++)
+        {
+            APEX_cpu_stop(cores[c]);
+        }
+        return 0;
+    }
+
+    return count;
+}
+
+/*
+ * This function runs the cores of a multi-core run to completion and reports every core, then the
+ * whole run with its simulator speed in simulated core cycles per host second
+ */
+static int
+run_multicore(const char *core_list, int quantum, int cycles_limit, const Memory_Options *options)
+{
+    APEX_CPU *cores[MULTICORE_MAX_CORES];
+    struct timespec start, end;
+    double host_seconds;
+    long long core_cycles = 0;
+    long long insn_completed = 0;
+    int max_clock = 0;
+    int status = 0;
+    int count;
+
+    count = init_cores(core_list, options, cores);
+    if (!count)
+    {
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (!multicore_run(cores, count, quantum, cycles_limit))
+    {
+        status = 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    host_seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    for (int c = 0; c < count; c++)
+    {
+        APEX_CPU *cpu = cores[c];
+
+        printf("core %-11d cycles %9d  insns %9d  IPC %6.3f%s\n", c, cpu->clock, cpu->insn_completed,
+               cpu->clock ? (double)cpu->insn_completed / cpu->clock : 0.0,
+               cpu->cosim_failed ? "  COSIM-FAIL" : (cpu->halt_cpu ? "" : "  CYCLE-LIMIT"));
+
+        if (cpu->clock > max_clock)
+        {
+            max_clock = cpu->clock;
+        }
+        core_cycles += cpu->clock;
+        insn_completed += cpu->insn_completed;
+        status |= cpu->cosim_failed;
+    }
+
+    printf("%-2d cores         cycles %9d  insns %9lld  IPC %6.3f  host %9.3f ms  %12.0f cycles/s\n",
+           count, max_clock, insn_completed, max_clock ? (double)insn_completed / max_clock : 0.0,
+           host_seconds * 1e3, host_seconds > 0 ? core_cycles / host_seconds : 0.0);
+
+    if (options->dump_file &&
+        !memory_image_dump(&cores[0]->data_memory, options->dump_file, options->dump_start, options->dump_count))
+    {
+        fprintf(stderr, "APEX_Error: Unable to dump data memory to %s\n", options->dump_file);
+        status = 1;
+    }
+
+    for (int c = 0; c < count; c++)
+    {
+        APEX_cpu_stop(cores[c]);
+    }
+
+    return status;
+}
+
+/*
+ * This function creates an SMT core running the programs of "<program>[@<entry_pc>],..." as its
+ * hardware threads. Returns NULL if a thread could not be created.
+ */
+static APEX_CPU *
+init_smt_cpu(const char *thread_list, const Memory_Options *options)
+{
+    APEX_CPU *cpu = NULL;
+    char *list = strdup(thread_list);
+    char *saveptr = NULL;
+    int failed = !list;
+
+    for (char *spec = list ? strtok_r(list, ",", &saveptr) : NULL; spec && !failed;
+         spec = strtok_r(NULL, ",", &saveptr))
+    {
+        char *at = strrchr(spec, '@');
+
+        if (at)
+        {
+            *at = '\0';
+        }
+
+        if (!cpu)
+        {
+            cpu = init_cpu(spec, options);
+            failed = !cpu;
+        }
+        else
+        {
+            failed = !APEX_cpu_add_thread(cpu, spec);
+        }
+
+        failed = failed || (at && !APEX_cpu_set_entry_pc(cpu, get_num_from_string(at + 1)));
+    }
+
+    free(list);
+
+    if (failed && cpu)
+    {
+        APEX_cpu_stop(cpu);
+        return NULL;
+    }
+
+    return cpu;
+}
+
+/*
+ * This function runs the threads of an SMT core to completion, fetching with the given policy ("icount"
+ * or "rr") and dividing the ROB and LSQ by the given one ("shared" or "partitioned"). It reports every
+ * thread, then the core with how busy its FUs and memory port were.
+ */
+static int
+run_smt(const char *thread_list, const char *fetch_policy, const char *queue_policy, int cycles_limit,
+        const Memory_Options *options)
+{
+    APEX_CPU *cpu;
+    struct timespec start, end;
+    double host_seconds;
+    int status;
+
+    cpu = init_smt_cpu(thread_list, options);
+    if (!cpu)
+    {
+        return 1;
+    }
+
+    if (strcmp(fetch_policy, "icount") == 0)
+    {
+        cpu->fetch_policy = SMT_FETCH_ICOUNT;
+    }
+    else if (strcmp(fetch_policy, "rr") == 0)
+    {
+        cpu->fetch_policy = SMT_FETCH_ROUND_ROBIN;
+    }
+    else
+    {
+        fprintf(stderr, "APEX_Error: Unknown fetch policy %s, expected icount or rr\n", fetch_policy);
+        APEX_cpu_stop(cpu);
+        return 1;
+    }
+
+    if (strcmp(queue_policy, "shared") == 0)
+    {
+        cpu->queue_policy = SMT_QUEUES_SHARED;
+    }
+    else if (strcmp(queue_policy, "partitioned") == 0)
+    {
+        cpu->queue_policy = SMT_QUEUES_PARTITIONED;
+    }
+    else
+    {
+        fprintf(stderr, "APEX_Error: Unknown ROB/LSQ policy %s, expected shared or partitioned\n", queue_policy);
+        APEX_cpu_stop(cpu);
+        return 1;
+    }
+
+    cpu->single_step = FALSE;
+    cpu->debug_messages = FALSE;
+    cpu->cycles_limit = cycles_limit;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    APEX_cpu_run(cpu);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    host_seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    for (int t = 0; t < cpu->thread_count; t++)
+    {
+        const APEX_Thread *thread = &cpu->threads[t];
+        int cycles = thread->halt_cycle != -1 ? thread->halt_cycle : cpu->clock;
+
+        printf("thread %-9d cycles %9d  insns %9d  IPC %6.3f%s\n", t, cycles, thread->insn_completed,
+               cycles ? (double)thread->insn_completed / cycles : 0.0,
+               thread->halt_cycle != -1 || cpu->halt_cpu ? "" : "  CYCLE-LIMIT");
+    }
+
+    printf("%d threads %-6s cycles %9d  insns %9d  IPC %6.3f  host %9.3f ms  %12.0f cycles/s%s\n",
+           cpu->thread_count, fetch_policy, cpu->clock, cpu->insn_completed,
+           cpu->clock ? (double)cpu->insn_completed / cpu->clock : 0.0,
+           host_seconds * 1e3, host_seconds > 0 ? cpu->clock / host_seconds : 0.0,
+           cpu->cosim_failed ? "  COSIM-FAIL" : "");
+
+    printf("busy INT FU %5.1f%%  address FU %5.1f%%  MUL FU %5.1f%%  DIV FU %5.1f%%  memory %5.1f%%\n",
+           cpu->clock ? 100.0 * cpu->stats.intFU_busy_cycles / cpu->clock : 0.0,
+           cpu->clock ? 100.0 * cpu->stats.addFU_busy_cycles / cpu->clock : 0.0,
+           cpu->clock ? 100.0 * cpu->stats.mulFU_busy_cycles / cpu->clock : 0.0,
+           cpu->clock ? 100.0 * cpu->stats.divFU_busy_cycles / cpu->clock : 0.0,
+           cpu->clock ? 100.0 * cpu->stats.mem_busy_cycles / cpu->clock : 0.0);
+
+    status = cpu->cosim_failed ? 1 : 0;
+    APEX_cpu_stop(cpu);
+
+    return status;
+}
+
 int
 main(int argc, char const *argv[])
 {
     APEX_CPU *cpu = NULL;
+    Memory_Options options;
     char command;
     int run_sim = TRUE;
 
+    if (!parse_memory_options(&argc, argv, &options))
+    {
+        fprintf(stderr, "APEX_Error: Malformed memory image option\n");
+        exit(1);
+    }
+
+    if (argc >= 3 && strcmp(argv[2], "batch") == 0)
+    {
+        return run_batch(argv[1], argc >= 4 ? get_num_from_string(argv[3]) : 0, &options);
+    }
+
+    if (argc >= 3 && strcmp(argv[2], "server") == 0)
+    {
+        int workers = argc >= 4 ? atoi(argv[3]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+        return job_server_run(argv[1], workers, argc >= 5 ? argv[4] : NULL,
+                              argc >= 6 ? get_num_from_string(argv[5]) : 0) == 0 ? 0 : 1;
+    }
+
+    if (argc >= 3 && strcmp(argv[2], "multicore") == 0)
+    {
+        return run_multicore(argv[1], argc >= 4 ? get_num_from_string(argv[3]) : 0,
+                             argc >= 5 ? get_num_from_string(argv[4]) : 0, &options);
+    }
+
+    if (argc >= 3 && strcmp(argv[2], "smt") == 0)
+    {
+        return run_smt(argv[1], argc >= 4 ? argv[3] : "icount", argc >= 5 ? argv[4] : "shared",
+                       argc >= 6 ? get_num_from_string(argv[5]) : 0, &options);
+    }
+
+    if (argc >= 3 && strcmp(argv[2], "script") == 0)
+    {
+        return run_script(argv[1], argc >= 4 ? argv[3] : NULL, &options);
+    }
+
     fprintf(stderr, "APEX CPU Pipeline Simulator v%0.1lf\n", VERSION);
 
     if (argc != 4)
     {
-        fprintf(stderr, "APEX_Help: Usage %s <input_file>\n", argv[0]);
+        fprintf(stderr, "APEX_Help: Usage %s <input_file> simulate <cycles>\n", argv[0]);
+        fprintf(stderr, "APEX_Help:       %s <input_file> batch [<cycles>]\n", argv[0]);
+        fprintf(stderr, "APEX_Help:       %s <input_file> script [<command_file>]\n", argv[0]);
+        fprintf(stderr, "APEX_Help:       %s <directory|manifest> server [<workers> [<report> [<cycles>]]]\n", argv[0]);
+        fprintf(stderr, "APEX_Help:       %s <input_file>[@<pc>],<input_file>[@<pc>],... multicore [<quantum> [<cycles>]]\n", argv[0]);
+        fprintf(stderr, "APEX_Help:       %s <input_file>[@<pc>],<input_file>[@<pc>],... smt [icount|rr [shared|partitioned [<cycles>]]]\n", argv[0]);
+        fprintf(stderr, "APEX_Help: Options --load-mem <image>[@<base>]  --dump-mem <file>[@<start>[:<count>]]\n");
+        fprintf(stderr, "APEX_Help: Images ending in .hex are hexadecimal text, any other is raw 32-bit words\n");
+        fprintf(stderr, "APEX_Help: Option --pipeview <file> writes an O3PipeView trace readable by Konata\n");
+        fprintf(stderr, "APEX_Help: Option --sample <file>[@<cycles>] writes the counters of every interval as CSV\n");
         exit(1);
     }
 
@@ -69,13 +605,17 @@ main(int argc, char const *argv[])
         switch(command) {
             case 'i':
             {
-                cpu = APEX_cpu_init(argv[1]);
+                cpu = init_cpu(argv[1], &options);
                 if (!cpu)
                 {
-                    fprintf(stderr, "APEX_Error: Unable to initialize CPU\n");
                     exit(1);
                 }
 
+                if (cpu->debug_messages)
+                {
+                    APEX_cpu_print_code_memory(cpu);
+                }
+
                 printf("\n%d\n", get_num_from_string(argv[3]));
                 cpu->cycles_limit = get_num_from_string(argv[3]);
                 break;
@@ -117,7 +657,13 @@ main(int argc, char const *argv[])
                 scanf("%d", &add);
                 getchar();
 
-                printf("\nMEM[%d] = %d\n", add, cpu->data_memory[add]);
+                int value;
+                if (!data_memory_read(&cpu->data_memory, add, &value)) {
+                    fprintf(stderr, "APEX_Error: Memory address %d is out of range\n", add);
+                    break;
+                }
+
+                printf("\nMEM[%d] = %d\n", add, value);
 
                 break;
             }
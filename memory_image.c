@@ -0,0 +1,299 @@
+/*
+ * memory_image.c
+ * Contains the loader and the dumper of data memory images
+ */
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "memory_image.h"
+
+#define HEX_WORDS_PER_LINE 8
+
+static const int zero_page[DATA_MEMORY_PAGE_SIZE];
+
+/*
+This method returns TRUE if the image file is in the text hexadecimal format
+*/
+static int
+is_hex_image(const char *filename)
+{
+    const char *extension = strrchr(filename, '.');
+
+    return extension && strcmp(extension, ".hex") == 0;
+}
+
+/*
+This method copies count words to data memory starting at address. Chunks of zero words falling
+on pages that were never touched are skipped, since those pages already read as zero.
+*/
+static int
+write_words(Data_Memory *mem, int address, const int *words, long count)
+{
+    while (count > 0)
+    {
+        int page_num = address >> DATA_MEMORY_PAGE_BITS;
+        int offset = address & (DATA_MEMORY_PAGE_SIZE - 1);
+        long chunk = DATA_MEMORY_PAGE_SIZE - offset < count ? DATA_MEMORY_PAGE_SIZE - offset : count;
+
+        if (mem->page_table[page_num] || memcmp(words, zero_page, chunk * sizeof(int)) != 0)
+        {
+            int *page = data_memory_page_lookup(mem, page_num, TRUE);
+
+            if (!page)
+            {
+                return FALSE;
+            }
+
+            memcpy(&page[offset], words, chunk * sizeof(int));
+        }
+
+        address += chunk;
+        words += chunk;
+        count -= chunk;
+    }
+
+    return TRUE;
+}
+
+/*
+This method maps a binary image and copies it to data memory starting at base
+*/
+static int
+load_binary_image(Data_Memory *mem, const char *filename, int base)
+{
+    struct stat st;
+    const int *words;
+    long count;
+    int status;
+    int fd = open(filename, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return FALSE;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size % sizeof(int) != 0)
+    {
+        close(fd);
+        return FALSE;
+    }
+
+    count = st.st_size / sizeof(int);
+    if (count > DATA_MEMORY_SIZE - base)
+    {
+        close(fd);
+        return FALSE;
+    }
+
+    if (count == 0)
+    {
+        close(fd);
+        return TRUE;
+    }
+
+    words = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (words == MAP_FAILED)
+    {
+        return FALSE;
+    }
+
+    madvise((void *)words, st.st_size, MADV_SEQUENTIAL);
+    status = write_words(mem, base, words, count);
+    munmap((void *)words, st.st_size);
+
+    return status;
+}
+
+/*
+This method reads a hexadecimal text image and writes it to data memory, word addresses are
+relative to base
+*/
+static int
+load_hex_image(Data_Memory *mem, const char *filename, int base)
+{
+    FILE *fp = fopen(filename, "r");
+    char *line = NULL;
+    size_t line_size = 0;
+    long address = base;
+    int status = TRUE;
+
+    if (!fp)
+    {
+        return FALSE;
+    }
+
+    while (status && getline(&line, &line_size, fp) != -1)
+    {
+        char *p = line;
+
+        while (status)
+        {
+            char *end;
+            unsigned long value;
+
+            while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+            {
+                p++;
+            }
+
+            if (*p == '\0' || *p == '#')
+            {
+                break;
+            }
+
+            if (*p == '@')
+            {
+                address = base + (long)strtoul(p + 1, &end, 16);
+                status = end != p + 1;
+            }
+            else
+            {
+                value = strtoul(p, &end, 16);
+                status = end != p && address >= 0 && address < DATA_MEMORY_SIZE &&
+                         ((value == 0 && !mem->page_table[address >> DATA_MEMORY_PAGE_BITS]) ||
+                          data_memory_write(mem, (int)address, (int)value));
+                address++;
+            }
+
+            p = end;
+        }
+    }
+
+    free(line);
+    fclose(fp);
+
+    return status;
+}
+
+/*
+This method loads a data memory image, its first word lands at address base. Returns FALSE if the
+file could not be read, is malformed or does not fit in data memory.
+*/
+int
+memory_image_load(Data_Memory *mem, const char *filename, int base)
+{
+    if (!data_memory_in_range(base))
+    {
+        return FALSE;
+    }
+
+    return is_hex_image(filename) ? load_hex_image(mem, filename, base)
+                                  : load_binary_image(mem, filename, base);
+}
+
+/*
+This method writes count words of data memory starting at start in the format of the file
+*/
+static int
+dump_range(FILE *fp, Data_Memory *mem, int start, int count, int hex)
+{
+    int value;
+
+    if (!hex)
+    {
+        while (count > 0)
+        {
+            int page_num = start >> DATA_MEMORY_PAGE_BITS;
+            int offset = start & (DATA_MEMORY_PAGE_SIZE - 1);
+            int chunk = DATA_MEMORY_PAGE_SIZE - offset < count ? DATA_MEMORY_PAGE_SIZE - offset : count;
+            const int *page = mem->page_table[page_num] ? mem->page_table[page_num] : zero_page;
+
+            if (fwrite(&page[offset], sizeof(int), chunk, fp) != (size_t)chunk)
+            {
+                return FALSE;
+            }
+
+            start += chunk;
+            count -= chunk;
+        }
+
+        return TRUE;
+    }
+
+    fprintf(fp, "@%x\n", start);
+    for (int i = 0; i < count; i++)
+    {
+        data_memory_read(mem, start + i, &value);
+        fprintf(fp, "%08x%c", (unsigned int)value,
+                (i % HEX_WORDS_PER_LINE == HEX_WORDS_PER_LINE - 1 || i == count - 1) ? '\n' : ' ');
+    }
+
+    return !ferror(fp);
+}
+
+/*
+This method dumps count words of data memory starting at start to a file. With count 0 the whole
+memory is dumped: a hex dump lists every touched page, a binary dump runs from address 0 to the end
+of the last touched page.
+*/
+int
+memory_image_dump(Data_Memory *mem, const char *filename, int start, int count)
+{
+    int hex = is_hex_image(filename);
+    int status = TRUE;
+    FILE *fp;
+
+    if (count < 0 || !data_memory_in_range(start) || count > DATA_MEMORY_SIZE - start)
+    {
+        return FALSE;
+    }
+
+    fp = fopen(filename, hex ? "w" : "wb");
+    if (!fp)
+    {
+        return FALSE;
+    }
+
+    if (count > 0)
+    {
+        status = dump_range(fp, mem, start, count, hex);
+    }
+    else if (hex)
+    {
+        /* One block per run of consecutive touched pages */
+        for (int i = 0; i < DATA_MEMORY_PAGES && status; i++)
+        {
+            int pages = 0;
+
+            while (i + pages < DATA_MEMORY_PAGES && mem->page_table[i + pages])
+            {
+                pages++;
+            }
+
+            if (pages > 0)
+            {
+                status = dump_range(fp, mem, i << DATA_MEMORY_PAGE_BITS, pages << DATA_MEMORY_PAGE_BITS, TRUE);
+                i += pages;
+            }
+        }
+    }
+    else
+    {
+        int last_page = -1;
+
+        for (int i = 0; i < DATA_MEMORY_PAGES; i++)
+        {
+            if (mem->page_table[i])
+            {
+                last_page = i;
+            }
+        }
+
+        status = dump_range(fp, mem, 0, (last_page + 1) << DATA_MEMORY_PAGE_BITS, FALSE);
+    }
+
+    if (fclose(fp) != 0)
+    {
+        status = FALSE;
+    }
+
+    return status;
+}
@@ -0,0 +1,21 @@
+/*
+ * memory_image.h
+ * Contains the loader and the dumper of data memory images
+ *
+ * Two formats are understood, chosen by the file name:
+ *  - "*.hex": text, one or more 32-bit words per line written in hexadecimal. A line "@<address>"
+ *    (hexadecimal word address) moves the next word to that address, '#' starts a comment.
+ *  - anything else: raw binary, 32-bit words in host byte order placed at consecutive addresses.
+ *    Binary images are memory-mapped, so large datasets are not read through stdio.
+ *
+ * Pages of an image holding only zero words are not allocated, the data memory stays sparse.
+ */
+#ifndef _MEMORY_IMAGE_H_
+#define _MEMORY_IMAGE_H_
+
+#include "data_memory.h"
+
+int memory_image_load(Data_Memory *mem, const char *filename, int base);
+int memory_image_dump(Data_Memory *mem, const char *filename, int start, int count);
+
+#endif
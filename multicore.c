@@ -0,0 +1,226 @@
+/*
+ * multicore.c
+ * Contains the multi-core simulation, which runs several APEX cores sharing one data memory on
+ * parallel host threads
+ *
+ * The shared memory is kept as one copy per core, the data memory of the core and that of its
+ * reference model: a core only ever touches its own copy while it runs, so no access of a quantum
+ * needs a lock. The copies are brought back in step at every quantum boundary by applying the store
+ * logs of all the cores to all of them.
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "multicore.h"
+
+typedef struct Multicore
+{
+    APEX_CPU **cores;
+    Store_Log logs[MULTICORE_MAX_CORES];
+    int count;
+    int threads;                /* Host threads running the cores, thread t runs cores t, t + threads, ... */
+    int quantum;
+    int cycles_limit;           /* 0 if the cores run until they all halt */
+    int quantum_end;            /* Cycle the current quantum ends at */
+    int done;
+    int failed;
+    pthread_mutex_t start_lock; /* Held while the threads are being created */
+    pthread_barrier_t barrier;
+} Multicore;
+
+typedef struct Core_Thread
+{
+    Multicore *mc;
+    int index;
+} Core_Thread;
+
+/*
+This method makes the stores of the quantum visible to every core, applying the logs in core order
+to the copy of the shared memory of every core and of the reference models of its threads
+*/
+static int
+publish_stores(Multicore *mc)
+{
+    for (int c = 0; c < mc->count; c++)
+    {
+        for (int d = 0; d < mc->count; d++)
+        {
+            if (!store_log_apply(&mc->logs[c], &mc->cores[d]->data_memory))
+            {
+                return FALSE;
+            }
+
+            for (int t = 0; t < mc->cores[d]->thread_count; t++)
+            {
+                if (!store_log_apply(&mc->logs[c], &mc->cores[d]->threads[t].golden.data_memory))
+                {
+                    return FALSE;
+                }
+            }
+        }
+    }
+
+    for (int c = 0; c < mc->count; c++)
+    {
+        store_log_clear(&mc->logs[c]);
+    }
+
+    return TRUE;
+}
+
+/*
+This method runs between two quanta on a single thread while the others wait: it publishes the
+stores of the quantum and decides whether another quantum is run
+*/
+static void
+end_quantum(Multicore *mc)
+{
+    int running = 0;
+
+    if (!publish_stores(mc))
+    {
+        fprintf(stderr, "APEX_Error: Unable to apply the stores of cycles up to %d to the shared memory\n",
+                mc->quantum_end);
+        mc->failed = TRUE;
+        mc->done = TRUE;
+        return;
+    }
+
+    for (int c = 0; c < mc->count; c++)
+    {
+        running += !mc->cores[c]->halt_cpu;
+    }
+
+    if (!running || (mc->cycles_limit > 0 && mc->quantum_end >= mc->cycles_limit))
+    {
+        mc->done = TRUE;
+        return;
+    }
+
+    mc->quantum_end += mc->quantum;
+    if (mc->cycles_limit > 0 && mc->quantum_end > mc->cycles_limit)
+    {
+        mc->quantum_end = mc->cycles_limit;
+    }
+}
+
+static void *
+core_thread(void *arg)
+{
+    Core_Thread *thread = arg;
+    Multicore *mc = thread->mc;
+
+    /* Wait until every thread is created, the number of threads is only known then */
+    pthread_mutex_lock(&mc->start_lock);
+    pthread_mutex_unlock(&mc->start_lock);
+
+    while (TRUE)
+    {
+        for (int c = thread->index; c < mc->count; c += mc->threads)
+        {
+            APEX_CPU *cpu = mc->cores[c];
+
+            while (!cpu->halt_cpu && cpu->clock < mc->quantum_end)
+            {
+                APEX_cpu_step(cpu);
+            }
+        }
+
+        if (pthread_barrier_wait(&mc->barrier) == PTHREAD_BARRIER_SERIAL_THREAD)
+        {
+            end_quantum(mc);
+        }
+        pthread_barrier_wait(&mc->barrier);
+
+        if (mc->done)
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+This method runs the cores, one host thread each, until they have all halted or the cycle limit is
+reached. The cores must not have run yet and must hold the same data memory. Returns FALSE if the
+run could not be carried out.
+*/
+int
+multicore_run(APEX_CPU **cores, int count, int quantum, int cycles_limit)
+{
+    Multicore mc = {0};
+    Core_Thread threads[MULTICORE_MAX_CORES];
+    pthread_t handles[MULTICORE_MAX_CORES];
+    int started = 0;
+    int logs = 0;
+
+    if (count < 1 || count > MULTICORE_MAX_CORES)
+    {
+        fprintf(stderr, "APEX_Error: A multi-core run takes 1 to %d cores\n", MULTICORE_MAX_CORES);
+        return FALSE;
+    }
+
+    mc.cores = cores;
+    mc.count = count;
+    mc.quantum = quantum > 0 ? quantum : MULTICORE_DEFAULT_QUANTUM;
+    mc.cycles_limit = cycles_limit;
+    mc.quantum_end = mc.quantum;
+    if (cycles_limit > 0 && mc.quantum_end > cycles_limit)
+    {
+        mc.quantum_end = cycles_limit;
+    }
+
+    for (; logs < count; logs++)
+    {
+        if (!store_log_init(&mc.logs[logs]))
+        {
+            fprintf(stderr, "APEX_Error: Unable to allocate the store log of core %d\n", logs);
+            mc.failed = TRUE;
+            break;
+        }
+        cores[logs]->store_log = &mc.logs[logs];
+    }
+
+    if (!mc.failed)
+    {
+        /* The calling thread runs core 0, and the cores of any thread that failed to start */
+        pthread_mutex_init(&mc.start_lock, NULL);
+        pthread_mutex_lock(&mc.start_lock);
+        for (int t = 1; t < count; t++)
+        {
+            threads[t].mc = &mc;
+            threads[t].index = t;
+            if (pthread_create(&handles[t], NULL, core_thread, &threads[t]) != 0)
+            {
+                break;
+            }
+            started++;
+        }
+
+        mc.threads = started + 1;
+        pthread_barrier_init(&mc.barrier, NULL, mc.threads);
+        pthread_mutex_unlock(&mc.start_lock);
+
+        threads[0].mc = &mc;
+        threads[0].index = 0;
+        core_thread(&threads[0]);
+
+        for (int t = 1; t <= started; t++)
+        {
+            pthread_join(handles[t], NULL);
+        }
+
+        pthread_barrier_destroy(&mc.barrier);
+        pthread_mutex_destroy(&mc.start_lock);
+    }
+
+    for (int c = 0; c < logs; c++)
+    {
+        cores[c]->store_log = NULL;
+        store_log_free(&mc.logs[c]);
+    }
+
+    return !mc.failed;
+}
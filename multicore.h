@@ -0,0 +1,28 @@
+/*
+ * multicore.h
+ * Contains the multi-core simulation, which runs several APEX cores sharing one data memory on
+ * parallel host threads
+ *
+ * Every core runs on its own host thread and advances a quantum of cycles independently of the other
+ * cores, then all the threads meet at a barrier. The cores run their own programs, or the same
+ * program from different entry PCs.
+ *
+ * Stores follow a simple release model: a store is visible to its own core as soon as it retires and
+ * to the other cores from the next quantum boundary on. At the boundary the stores of the quantum are
+ * applied to the shared memory core by core, in core order, each core's stores in program order; when
+ * two cores stored to the same address in the same quantum the higher numbered core wins. A quantum
+ * of 1 cycle makes every store visible to every core the cycle after it retires.
+ *
+ * The run only depends on the programs and the quantum, never on how the host schedules the threads.
+ */
+#ifndef _MULTICORE_H_
+#define _MULTICORE_H_
+
+#include "apex_cpu.h"
+
+#define MULTICORE_MAX_CORES 16
+#define MULTICORE_DEFAULT_QUANTUM 100   /* Cycles the cores advance between two barriers */
+
+int multicore_run(APEX_CPU **cores, int count, int quantum, int cycles_limit);
+
+#endif
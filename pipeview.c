@@ -0,0 +1,180 @@
+/*
+ * pipeview.c
+ * Contains the per-instruction pipeline trace written in the gem5 O3PipeView format
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "apex_cpu.h"
+#include "pipeview.h"
+
+/* Room always left in the buffer for one full record */
+#define PIPEVIEW_RECORD_MAX 1024
+
+static const char *stage_names[PIPEVIEW_STAGES] = {
+    "fetch", "decode", "rename", "dispatch", "issue", "complete"
+};
+
+Pipeview *
+pipeview_open(const char *filename)
+{
+    Pipeview *pv = calloc(1, sizeof(Pipeview));
+
+    if (!pv)
+    {
+        return NULL;
+    }
+
+    pv->fp = fopen(filename, "w");
+    if (!pv->fp)
+    {
+        free(pv);
+        return NULL;
+    }
+
+    return pv;
+}
+
+static void
+pipeview_flush(Pipeview *pv)
+{
+    fwrite(pv->buffer, 1, pv->buffered, pv->fp);
+    pv->buffered = 0;
+}
+
+/*
+This method writes out what is buffered and closes the trace. Instructions still in flight are dropped.
+*/
+void
+pipeview_close(Pipeview *pv)
+{
+    if (!pv)
+    {
+        return;
+    }
+
+    pipeview_flush(pv);
+    fclose(pv->fp);
+    free(pv);
+}
+
+/*
+This method starts the record of a fetched instruction
+*/
+void
+pipeview_fetch(Pipeview *pv, int seq, int pc, const APEX_Instruction *insn, int cycle)
+{
+    Pipeview_Record *record = &pv->window[seq % PIPEVIEW_WINDOW];
+
+    memset(record, 0, sizeof(Pipeview_Record));
+    record->seq = seq;
+    record->pc = pc;
+    record->insn = insn;
+    record->cycle[PIPEVIEW_FETCH] = cycle;
+}
+
+/*
+This method formats the instruction the way the pipeline tables print it
+*/
+static void
+format_instruction(char *buf, size_t size, const APEX_Instruction *insn)
+{
+    char opcode_str[128];
+
+    /* The mnemonic of the last line of a program can still carry its line end */
+    snprintf(opcode_str, sizeof(opcode_str), "%s", insn->opcode_str);
+    opcode_str[strcspn(opcode_str, "\r\n")] = '\0';
+
+    switch (insn->opcode)
+    {
+        case OPCODE_ADD:
+        case OPCODE_SUB:
+        case OPCODE_MUL:
+        case OPCODE_DIV:
+        case OPCODE_AND:
+        case OPCODE_OR:
+        case OPCODE_XOR:
+            snprintf(buf, size, "%s,R%d,R%d,R%d", opcode_str, insn->rd, insn->rs1, insn->rs2);
+            break;
+
+        case OPCODE_MOVC:
+            snprintf(buf, size, "%s,R%d,#%d", opcode_str, insn->rd, insn->imm);
+            break;
+
+        case OPCODE_JUMP:
+        case OPCODE_CML:
+            snprintf(buf, size, "%s,R%d,#%d", opcode_str, insn->rs1, insn->imm);
+            break;
+
+        case OPCODE_LOAD:
+        case OPCODE_LOADP:
+        case OPCODE_ADDL:
+        case OPCODE_SUBL:
+        case OPCODE_JALR:
+            snprintf(buf, size, "%s,R%d,R%d,#%d", opcode_str, insn->rd, insn->rs1, insn->imm);
+            break;
+
+        case OPCODE_STORE:
+        case OPCODE_STOREP:
+            snprintf(buf, size, "%s,R%d,R%d,#%d", opcode_str, insn->rs1, insn->rs2, insn->imm);
+            break;
+
+        case OPCODE_BZ:
+        case OPCODE_BNZ:
+        case OPCODE_BP:
+        case OPCODE_BNP:
+        case OPCODE_BN:
+        case OPCODE_BNN:
+            snprintf(buf, size, "%s,#%d", opcode_str, insn->imm);
+            break;
+
+        case OPCODE_CMP:
+            snprintf(buf, size, "%s,R%d,R%d", opcode_str, insn->rs1, insn->rs2);
+            break;
+
+        default:
+            snprintf(buf, size, "%s", opcode_str);
+            break;
+    }
+}
+
+/*
+This method completes the record of a retiring instruction and appends it to the trace
+*/
+void
+pipeview_retire(Pipeview *pv, int seq, int cycle, int is_store)
+{
+    const Pipeview_Record *record = &pv->window[seq % PIPEVIEW_WINDOW];
+    char disasm[160];
+    char *out;
+
+    if (record->seq != seq || !record->insn)
+    {
+        return;
+    }
+
+    if (pv->buffered > PIPEVIEW_BUFFER_SIZE - PIPEVIEW_RECORD_MAX)
+    {
+        pipeview_flush(pv);
+    }
+
+    format_instruction(disasm, sizeof(disasm), record->insn);
+
+    out = pv->buffer + pv->buffered;
+    out += sprintf(out, "O3PipeView:fetch:%lld:0x%08x:0:%d:%s\n",
+                   (long long)record->cycle[PIPEVIEW_FETCH] * PIPEVIEW_TICKS_PER_CYCLE,
+                   (unsigned int)record->pc, seq, disasm);
+
+    for (int stage = PIPEVIEW_DECODE; stage < PIPEVIEW_STAGES; stage++)
+    {
+        out += sprintf(out, "O3PipeView:%s:%lld\n", stage_names[stage],
+                       (long long)record->cycle[stage] * PIPEVIEW_TICKS_PER_CYCLE);
+    }
+
+    out += sprintf(out, "O3PipeView:retire:%lld:store:%lld\n",
+                   (long long)cycle * PIPEVIEW_TICKS_PER_CYCLE,
+                   is_store ? (long long)cycle * PIPEVIEW_TICKS_PER_CYCLE : 0LL);
+
+    pv->buffered = out - pv->buffer;
+}
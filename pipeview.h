@@ -0,0 +1,87 @@
+/*
+ * pipeview.h
+ * Contains the per-instruction pipeline trace written in the gem5 O3PipeView format
+ *
+ * Konata and gem5's o3-pipeview.py both read this format. The APEX stages are mapped
+ * onto its fields as:
+ *   fetch    - the instruction is fetched
+ *   decode   - it leaves decode/rename with its registers renamed
+ *   rename   - it leaves rename/dispatch into Godzilla
+ *   dispatch - it enters the IQ/ROB (and the LSQ)
+ *   issue    - it is selected from the IQ into an FU
+ *   complete - the FU produced its result, or the load data came back from memory
+ *   retire   - it retires from the ROB head, stores write memory in the same cycle
+ * Stages an instruction skips (issue and complete of NOP, HALT and the instructions completed at
+ * rename) are written as 0.
+ * An instruction fused into the one before it shares that one's stages from decode on.
+ * One cycle is PIPEVIEW_TICKS_PER_CYCLE ticks.
+ *
+ * Records of in-flight instructions live in a window indexed by sequence number and are
+ * written out when the instruction retires, through a buffer flushed in large blocks.
+ */
+#ifndef _PIPEVIEW_H_
+#define _PIPEVIEW_H_
+
+#include <stdio.h>
+
+#include "apex_macros.h"
+
+/* Must exceed the number of instructions in flight: the front-end latches plus the ROB */
+#define PIPEVIEW_WINDOW 128
+#define PIPEVIEW_TICKS_PER_CYCLE 1000
+#define PIPEVIEW_BUFFER_SIZE (1 << 16)
+
+/* Stages stamped in a record */
+#define PIPEVIEW_FETCH 0
+#define PIPEVIEW_DECODE 1
+#define PIPEVIEW_RENAME 2
+#define PIPEVIEW_DISPATCH 3
+#define PIPEVIEW_ISSUE 4
+#define PIPEVIEW_COMPLETE 5
+#define PIPEVIEW_STAGES 6
+
+struct APEX_Instruction;
+
+typedef struct Pipeview_Record
+{
+    int seq;
+    int pc;
+    const struct APEX_Instruction *insn;
+    int cycle[PIPEVIEW_STAGES];     /* 0 if the stage was not reached */
+} Pipeview_Record;
+
+typedef struct Pipeview
+{
+    FILE *fp;
+    Pipeview_Record window[PIPEVIEW_WINDOW];
+    char buffer[PIPEVIEW_BUFFER_SIZE];
+    int buffered;                   /* Bytes of buffer waiting to be written */
+} Pipeview;
+
+Pipeview *pipeview_open(const char *filename);
+void pipeview_close(Pipeview *pv);
+void pipeview_fetch(Pipeview *pv, int seq, int pc, const struct APEX_Instruction *insn, int cycle);
+void pipeview_retire(Pipeview *pv, int seq, int cycle, int is_store);
+
+/*
+This method records the cycle an in-flight instruction reached a stage
+*/
+static inline void
+pipeview_stamp(Pipeview *pv, int seq, int stage, int cycle)
+{
+    pv->window[seq % PIPEVIEW_WINDOW].cycle[stage] = cycle;
+}
+
+/*
+This method gives an instruction fused into the one before it the stages of that one, from decode on
+*/
+static inline void
+pipeview_fuse(Pipeview *pv, int seq, int fused_seq)
+{
+    for (int stage = PIPEVIEW_DECODE; stage < PIPEVIEW_STAGES; stage++)
+    {
+        pv->window[fused_seq % PIPEVIEW_WINDOW].cycle[stage] = pv->window[seq % PIPEVIEW_WINDOW].cycle[stage];
+    }
+}
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ * stat_sampler.c
+ * Contains the interval sampler, which snapshots the run counters every fixed number of cycles
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "stat_sampler.h"
+
+/*
+This method writes the row of the interval that ends at sample
+*/
+static void
+write_sample(FILE *fp, const Stat_Sample *sample, const Stat_Sample *last)
+{
+    long long cycles = sample->cycle - last->cycle;
+    long long insns = sample->insn_completed - last->insn_completed;
+
+    fprintf(fp, "%lld,%lld,%.3f,%d,%d,%d,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld\n",
+            sample->cycle, insns, cycles ? (double)insns / cycles : 0.0,
+            sample->iq_occupancy, sample->rob_occupancy, sample->lsq_occupancy,
+            sample->iq_full_stall_cycles - last->iq_full_stall_cycles,
+            sample->rob_full_stall_cycles - last->rob_full_stall_cycles,
+            sample->lsq_full_stall_cycles - last->lsq_full_stall_cycles,
+            sample->free_list_stall_cycles - last->free_list_stall_cycles,
+            sample->intFU_busy_cycles - last->intFU_busy_cycles,
+            sample->addFU_busy_cycles - last->addFU_busy_cycles,
+            sample->mulFU_busy_cycles - last->mulFU_busy_cycles,
+            sample->divFU_busy_cycles - last->divFU_busy_cycles,
+            sample->mem_busy_cycles - last->mem_busy_cycles);
+}
+
+/*
+This method is the writer thread: it sleeps until half the ring is filled, writes out every sample
+pushed so far and hands the slots back to the simulator
+*/
+static void *
+stat_sampler_writer(void *arg)
+{
+    Stat_Sampler *sampler = arg;
+    long long tail = 0;
+    long long head;
+
+    while (TRUE)
+    {
+        pthread_mutex_lock(&sampler->lock);
+        while (!sampler->stopping && sampler->head - tail < STAT_SAMPLER_RING / 2)
+        {
+            pthread_cond_wait(&sampler->filled, &sampler->lock);
+        }
+        head = sampler->head;
+        pthread_mutex_unlock(&sampler->lock);
+
+        if (head == tail)
+        {
+            break;
+        }
+
+        /* The simulator does not reuse these slots until tail moves past them */
+        for (; tail < head; tail++)
+        {
+            const Stat_Sample *sample = &sampler->ring[tail % STAT_SAMPLER_RING];
+
+            write_sample(sampler->fp, sample, &sampler->last);
+            sampler->last = *sample;
+        }
+        fflush(sampler->fp);
+
+        pthread_mutex_lock(&sampler->lock);
+        sampler->tail = tail;
+        pthread_cond_signal(&sampler->drained);
+        pthread_mutex_unlock(&sampler->lock);
+    }
+
+    return NULL;
+}
+
+/*
+This method creates the sampler writing to filename and starts its writer thread. Returns NULL if
+the file cannot be created.
+*/
+Stat_Sampler *
+stat_sampler_open(const char *filename, int interval)
+{
+    Stat_Sampler *sampler = calloc(1, sizeof(Stat_Sampler));
+
+    if (!sampler)
+    {
+        return NULL;
+    }
+
+    sampler->fp = fopen(filename, "w");
+    if (!sampler->fp)
+    {
+        free(sampler);
+        return NULL;
+    }
+
+    sampler->interval = interval > 0 ? interval : STAT_SAMPLER_INTERVAL;
+    sampler->next_cycle = sampler->interval;
+    pthread_mutex_init(&sampler->lock, NULL);
+    pthread_cond_init(&sampler->filled, NULL);
+    pthread_cond_init(&sampler->drained, NULL);
+
+    fprintf(sampler->fp, "cycle,instructions,ipc,iq_occupancy,rob_occupancy,lsq_occupancy,"
+                         "iq_full_stalls,rob_full_stalls,lsq_full_stalls,free_list_stalls,"
+                         "intFU_busy,addFU_busy,mulFU_busy,divFU_busy,mem_busy\n");
+
+    if (pthread_create(&sampler->writer, NULL, stat_sampler_writer, sampler) != 0)
+    {
+        fclose(sampler->fp);
+        pthread_mutex_destroy(&sampler->lock);
+        pthread_cond_destroy(&sampler->filled);
+        pthread_cond_destroy(&sampler->drained);
+        free(sampler);
+        return NULL;
+    }
+
+    return sampler;
+}
+
+/*
+This method queues a snapshot for the writer and schedules the next one
+*/
+void
+stat_sampler_push(Stat_Sampler *sampler, const Stat_Sample *sample)
+{
+    pthread_mutex_lock(&sampler->lock);
+    while (sampler->head - sampler->tail == STAT_SAMPLER_RING)
+    {
+        pthread_cond_wait(&sampler->drained, &sampler->lock);
+    }
+
+    sampler->ring[sampler->head % STAT_SAMPLER_RING] = *sample;
+    sampler->head++;
+
+    if (sampler->head - sampler->tail >= STAT_SAMPLER_RING / 2)
+    {
+        pthread_cond_signal(&sampler->filled);
+    }
+    pthread_mutex_unlock(&sampler->lock);
+
+    sampler->pushed_cycle = sample->cycle;
+
+    /* Idle cycle skipping can jump over several due cycles at once */
+    while (sampler->next_cycle <= sample->cycle)
+    {
+        sampler->next_cycle += sampler->interval;
+    }
+}
+
+/*
+This method waits for the writer to write out every queued sample, then closes the file
+*/
+void
+stat_sampler_close(Stat_Sampler *sampler)
+{
+    if (!sampler)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&sampler->lock);
+    sampler->stopping = TRUE;
+    pthread_cond_signal(&sampler->filled);
+    pthread_mutex_unlock(&sampler->lock);
+
+    pthread_join(sampler->writer, NULL);
+
+    fclose(sampler->fp);
+    pthread_mutex_destroy(&sampler->lock);
+    pthread_cond_destroy(&sampler->filled);
+    pthread_cond_destroy(&sampler->drained);
+    free(sampler);
+}
@@ -0,0 +1,60 @@
+/*
+ * stat_sampler.h
+ * Contains the interval sampler, which snapshots the run counters every fixed number of cycles
+ *
+ * The simulator pushes snapshots into a preallocated ring and never touches the file: a writer
+ * thread drains the ring whenever it is half full and writes one CSV row per interval. Counters
+ * are written as the change over the interval, occupancies as seen at the end of it. When the
+ * writer falls a whole ring behind, the simulator waits for it rather than drop samples.
+ */
+#ifndef _STAT_SAMPLER_H_
+#define _STAT_SAMPLER_H_
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include "apex_macros.h"
+
+#define STAT_SAMPLER_INTERVAL 1000      /* Default cycles between two samples */
+#define STAT_SAMPLER_RING 1024          /* Snapshots held before the simulator has to wait */
+
+typedef struct Stat_Sample
+{
+    long long cycle;
+    long long insn_completed;
+    int iq_occupancy;
+    int rob_occupancy;
+    int lsq_occupancy;
+    long long iq_full_stall_cycles;
+    long long rob_full_stall_cycles;
+    long long lsq_full_stall_cycles;
+    long long free_list_stall_cycles;
+    long long intFU_busy_cycles;
+    long long addFU_busy_cycles;
+    long long mulFU_busy_cycles;
+    long long divFU_busy_cycles;
+    long long mem_busy_cycles;
+} Stat_Sample;
+
+typedef struct Stat_Sampler
+{
+    FILE *fp;
+    int interval;
+    long long next_cycle;               /* Cycle the next sample is due */
+    long long pushed_cycle;             /* Cycle of the latest sample pushed */
+    Stat_Sample ring[STAT_SAMPLER_RING];
+    long long head;                     /* Samples pushed, only written by the simulator */
+    long long tail;                     /* Samples written out, only written by the writer */
+    Stat_Sample last;                   /* Previous sample written, the base of the next interval */
+    int stopping;
+    pthread_mutex_t lock;
+    pthread_cond_t filled;              /* Signalled when the ring is half full or on close */
+    pthread_cond_t drained;             /* Signalled when the writer frees ring slots */
+    pthread_t writer;
+} Stat_Sampler;
+
+Stat_Sampler *stat_sampler_open(const char *filename, int interval);
+void stat_sampler_push(Stat_Sampler *sampler, const Stat_Sample *sample);
+void stat_sampler_close(Stat_Sampler *sampler);
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * store_log.c
+ * Contains the log of the stores a core of a multi-core simulation made during the current quantum
+ */
+#include <stdlib.h>
+
+#include "store_log.h"
+
+int
+store_log_init(Store_Log *log)
+{
+    log->address = malloc(STORE_LOG_INITIAL_SIZE * sizeof(int));
+    log->value = malloc(STORE_LOG_INITIAL_SIZE * sizeof(int));
+    log->count = 0;
+    log->capacity = STORE_LOG_INITIAL_SIZE;
+
+    if (!log->address || !log->value)
+    {
+        store_log_free(log);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void
+store_log_free(Store_Log *log)
+{
+    free(log->address);
+    free(log->value);
+    log->address = NULL;
+    log->value = NULL;
+    log->count = 0;
+    log->capacity = 0;
+}
+
+/*
+This method appends a store to the log, doubling the log when it is full. Returns FALSE if the log
+could not grow.
+*/
+int
+store_log_append(Store_Log *log, int address, int value)
+{
+    if (log->count == log->capacity)
+    {
+        int capacity = log->capacity * 2;
+        int *addresses = realloc(log->address, capacity * sizeof(int));
+        int *values;
+
+        if (!addresses)
+        {
+            return FALSE;
+        }
+        log->address = addresses;
+
+        values = realloc(log->value, capacity * sizeof(int));
+        if (!values)
+        {
+            return FALSE;
+        }
+        log->value = values;
+        log->capacity = capacity;
+    }
+
+    log->address[log->count] = address;
+    log->value[log->count] = value;
+    log->count++;
+
+    return TRUE;
+}
+
+/*
+This method writes the logged stores to mem in the order they were made. Returns FALSE if a page of
+mem could not be allocated.
+*/
+int
+store_log_apply(const Store_Log *log, Data_Memory *mem)
+{
+    for (int i = 0; i < log->count; i++)
+    {
+        if (!data_memory_write(mem, log->address[i], log->value[i]))
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+void
+store_log_clear(Store_Log *log)
+{
+    log->count = 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * store_log.h
+ * Contains the log of the stores a core of a multi-core simulation made during the current quantum
+ *
+ * Every core of a multi-core simulation works on its own copy of the shared data memory. A store
+ * writes the copy of its core right away, so the core sees its own stores in program order, and is
+ * appended to the log of the core. At the end of every quantum the logs are applied to the copies of
+ * all the cores, so the stores of a core become visible to the other cores at the quantum boundary.
+ */
+#ifndef _STORE_LOG_H_
+#define _STORE_LOG_H_
+
+#include "apex_macros.h"
+#include "data_memory.h"
+
+#define STORE_LOG_INITIAL_SIZE 256
+
+typedef struct Store_Log
+{
+    int *address;
+    int *value;
+    int count;          /* Stores logged since the last store_log_clear() */
+    int capacity;
+} Store_Log;
+
+int store_log_init(Store_Log *log);
+void store_log_free(Store_Log *log);
+int store_log_append(Store_Log *log, int address, int value);
+int store_log_apply(const Store_Log *log, Data_Memory *mem);
+void store_log_clear(Store_Log *log);
+
+#endif
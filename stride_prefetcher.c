@@ -0,0 +1,95 @@
+/*
+ * stride_prefetcher.c
+ * Contains the stride prefetcher, which fills the data cache ahead of the address streams of the loads and stores
+ */
+#include "data_memory.h"
+#include "stride_prefetcher.h"
+
+static int
+stride_pf_index(int pc)
+{
+    return (pc >> 2) & (STRIDE_PF_SIZE - 1);
+}
+
+void
+stride_prefetcher_init(Stride_Prefetcher *pf)
+{
+    for (int i = 0; i < STRIDE_PF_SIZE; i++)
+    {
+        pf->pc[i] = -1;
+        pf->last_address[i] = 0;
+        pf->stride[i] = 0;
+        pf->confidence[i] = 0;
+    }
+}
+
+/*
+This method trains the entry of pc with the address its instruction accesses and, once the entry is
+confident, prefetches the lines of the stream ahead of it into the data cache. Returns the number of
+prefetches issued.
+*/
+int
+stride_prefetcher_train(Stride_Prefetcher *pf, Data_Cache *dc, int pc, int address, int now)
+{
+    int i = stride_pf_index(pc);
+    int stride;
+    int step;
+    int issued = 0;
+
+    if (pf->pc[i] != pc)
+    {
+        pf->pc[i] = pc;
+        pf->last_address[i] = address;
+        pf->stride[i] = 0;
+        pf->confidence[i] = 0;
+        return 0;
+    }
+
+    stride = address - pf->last_address[i];
+    pf->last_address[i] = address;
+
+    if (stride == 0)
+    {
+        return 0;
+    }
+
+    if (stride != pf->stride[i])
+    {
+        pf->stride[i] = stride;
+        pf->confidence[i] = 0;
+        return 0;
+    }
+
+    if (pf->confidence[i] < STRIDE_PF_CONFIDENCE)
+    {
+        pf->confidence[i]++;
+    }
+
+    if (pf->confidence[i] < STRIDE_PF_CONFIDENCE)
+    {
+        return 0;
+    }
+
+    /* Walk the stream a line at a time when the stride is shorter than a line */
+    step = stride;
+    if (step > 0 && step < DCACHE_LINE_SIZE)
+    {
+        step = DCACHE_LINE_SIZE;
+    }
+    else if (step < 0 && step > -DCACHE_LINE_SIZE)
+    {
+        step = -DCACHE_LINE_SIZE;
+    }
+
+    for (int n = 0; n < PREFETCH_DEGREE; n++)
+    {
+        int target = address + step * (PREFETCH_DISTANCE + n);
+
+        if (data_memory_in_range(target) && data_cache_prefetch(dc, target, now))
+        {
+            issued++;
+        }
+    }
+
+    return issued;
+}
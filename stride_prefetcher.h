@@ -0,0 +1,35 @@
+/*
+ * stride_prefetcher.h
+ * Contains the stride prefetcher, which fills the data cache ahead of the address streams of the loads and stores
+ *
+ * The prefetcher is a direct-mapped table indexed by PC, trained with the address every LOAD, STORE,
+ * LOADP and STOREP computes in the address FU. An entry holds the last address of its instruction and
+ * the stride between its last two addresses. Once the same nonzero stride has repeated
+ * STRIDE_PF_CONFIDENCE times in a row, every access of the instruction prefetches PREFETCH_DEGREE lines
+ * of the stream, starting PREFETCH_DISTANCE lines ahead of the access. The post-increment of LOADP and
+ * STOREP makes a stream of stride 4 the prefetcher locks onto after a few iterations.
+ *
+ * A stride shorter than a cache line is prefetched a line at a time, lines already in the cache or
+ * being filled are skipped.
+ */
+#ifndef _STRIDE_PREFETCHER_H_
+#define _STRIDE_PREFETCHER_H_
+
+#include "apex_macros.h"
+#include "data_cache.h"
+
+#define STRIDE_PF_SIZE 64               /* Table entries, must be a power of two */
+#define STRIDE_PF_CONFIDENCE 2          /* Strides repeated in a row before the entry prefetches */
+
+typedef struct Stride_Prefetcher
+{
+    int pc[STRIDE_PF_SIZE];             /* PC the entry was trained by, -1 if empty */
+    int last_address[STRIDE_PF_SIZE];
+    int stride[STRIDE_PF_SIZE];
+    int confidence[STRIDE_PF_SIZE];
+} Stride_Prefetcher;
+
+void stride_prefetcher_init(Stride_Prefetcher *pf);
+int stride_prefetcher_train(Stride_Prefetcher *pf, Data_Cache *dc, int pc, int address, int now);
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * tag_cam.h
+ * Contains the tag-match CAM used by broadcast wakeup
+ *
+ * Every source tag of a queue is compared against every tag broadcast in a cycle at once and
+ * the result comes back as a bitset with one bit per queue entry. The compare is done 8 entries
+ * at a time with AVX2, 4 at a time with SSE2, and one at a time otherwise.
+ * Set ENABLE_SIMD_CAM to 0 in apex_macros.h to force the scalar loop.
+ */
+#ifndef _TAG_CAM_H_
+#define _TAG_CAM_H_
+
+#include "apex_macros.h"
+#include "bitset.h"
+
+#if ENABLE_SIMD_CAM && (defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
+
+/*
+This method sets bit i of match if tags[i] equals any of the broadcast tags, for i < entries.
+match must hold BITSET_WORDS(entries) words.
+*/
+static inline void
+tag_cam_match(const int *tags, int entries, const int *broadcast, int broadcast_count, uint64_t *match)
+{
+    int i = 0;
+
+    for (int w = 0; w < BITSET_WORDS(entries); w++)
+    {
+        match[w] = 0;
+    }
+
+    if (broadcast_count == 0)
+    {
+        return;
+    }
+
+#if ENABLE_SIMD_CAM && defined(__AVX2__)
+    for (; i + 8 <= entries; i += 8)
+    {
+        __m256i src = _mm256_loadu_si256((const __m256i *)&tags[i]);
+        __m256i eq = _mm256_setzero_si256();
+
+        for (int t = 0; t < broadcast_count; t++)
+        {
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(src, _mm256_set1_epi32(broadcast[t])));
+        }
+        match[i >> 6] |= (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(eq)) << (i & 63);
+    }
+#elif ENABLE_SIMD_CAM && defined(__SSE2__)
+    for (; i + 4 <= entries; i += 4)
+    {
+        __m128i src = _mm_loadu_si128((const __m128i *)&tags[i]);
+        __m128i eq = _mm_setzero_si128();
+
+        for (int t = 0; t < broadcast_count; t++)
+        {
+            eq = _mm_or_si128(eq, _mm_cmpeq_epi32(src, _mm_set1_epi32(broadcast[t])));
+        }
+        match[i >> 6] |= (uint64_t)_mm_movemask_ps(_mm_castsi128_ps(eq)) << (i & 63);
+    }
+#endif
+
+    /* Entries left over after the last full vector */
+    for (; i < entries; i++)
+    {
+        for (int t = 0; t < broadcast_count; t++)
+        {
+            if (tags[i] == broadcast[t])
+            {
+                bitset_set(match, i);
+                break;
+            }
+        }
+    }
+}
+
+#endif
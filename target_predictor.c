@@ -0,0 +1,93 @@
+/*
+ * target_predictor.c
+ * Contains the target predictors of the register-indirect control transfers, JALR and JUMP
+ */
+#include "target_predictor.h"
+
+static int
+itt_index(int pc)
+{
+    return (pc >> 2) & (ITT_SIZE - 1);
+}
+
+void
+target_predictor_init(Target_Predictor *tp)
+{
+    tp->ras_top = 0;
+    tp->ras_count = 0;
+
+    for (int i = 0; i < ITT_SIZE; i++)
+    {
+        tp->itt_pc[i] = -1;
+        tp->itt_target[i] = 0;
+    }
+}
+
+/*
+This method predicts the target of the JUMP or JALR fetched at pc and updates the return-address
+stack for it. Returns the predictor that supplied *target, TARGET_PRED_NONE if there is no prediction.
+*/
+int
+target_predictor_predict(Target_Predictor *tp, int opcode, int pc, int rs1, int rd, int *target)
+{
+    int top = (tp->ras_top + RAS_SIZE - 1) % RAS_SIZE;
+    int i = itt_index(pc);
+    int source = TARGET_PRED_NONE;
+
+    if (opcode == OPCODE_JUMP && tp->ras_count > 0 && tp->ras_link[top] == rs1)
+    {
+        *target = tp->ras_target[top];
+        tp->ras_top = top;
+        tp->ras_count--;
+        return TARGET_PRED_RAS;
+    }
+
+    if (tp->itt_pc[i] == pc)
+    {
+        *target = tp->itt_target[i];
+        source = TARGET_PRED_ITT;
+    }
+
+    if (opcode == OPCODE_JALR)
+    {
+        tp->ras_target[tp->ras_top] = pc + 4;
+        tp->ras_link[tp->ras_top] = rd;
+        tp->ras_top = (tp->ras_top + 1) % RAS_SIZE;
+        if (tp->ras_count < RAS_SIZE)
+        {
+            tp->ras_count++;
+        }
+    }
+
+    return source;
+}
+
+/*
+This method records the resolved target of the indirect transfer at pc
+*/
+void
+target_predictor_train(Target_Predictor *tp, int pc, int target)
+{
+    int i = itt_index(pc);
+
+    tp->itt_pc[i] = pc;
+    tp->itt_target[i] = target;
+}
+
+/*
+This method returns the return-address stack pointers, to be restored if the path after a branch is squashed
+*/
+Ras_State
+target_predictor_ras_state(const Target_Predictor *tp)
+{
+    Ras_State state = { tp->ras_top, tp->ras_count };
+
+    return state;
+}
+
+void
+target_predictor_ras_restore(Target_Predictor *tp, Ras_State state)
+{
+    tp->ras_top = state.top;
+    tp->ras_count = state.count;
+}
@@ -0,0 +1,49 @@
+/*
+ * target_predictor.h
+ * Contains the target predictors of the register-indirect control transfers, JALR and JUMP
+ *
+ * A JALR is taken as a call: fetch pushes its return address on the return-address stack together
+ * with the link register it writes. A JUMP through the link register of the call on top of the stack
+ * is taken as the matching return and pops it. Every other JUMP, and every JALR, is predicted by the
+ * indirect-target table, a direct-mapped table holding the last target resolved at a PC.
+ *
+ * The stack is updated at fetch, on the predicted path. A branch keeps the stack pointers as they were
+ * after its own fetch, and a misprediction puts them back; entries overwritten on the wrong path are lost.
+ */
+#ifndef _TARGET_PREDICTOR_H_
+#define _TARGET_PREDICTOR_H_
+
+#include "apex_macros.h"
+
+#define RAS_SIZE 8                  /* Calls tracked, deeper nesting overwrites the oldest */
+#define ITT_SIZE 64                 /* Indirect-target table entries, must be a power of two */
+
+/* Which predictor supplied a target */
+#define TARGET_PRED_NONE 0
+#define TARGET_PRED_RAS 1
+#define TARGET_PRED_ITT 2
+
+/* Return-address stack pointers saved at a branch */
+typedef struct Ras_State
+{
+    int top;
+    int count;
+} Ras_State;
+
+typedef struct Target_Predictor
+{
+    int ras_target[RAS_SIZE];
+    int ras_link[RAS_SIZE];         /* Register the call wrote its return address to */
+    int ras_top;                    /* Slot the next call is pushed to */
+    int ras_count;
+    int itt_pc[ITT_SIZE];           /* PC the entry was trained by, -1 if empty */
+    int itt_target[ITT_SIZE];
+} Target_Predictor;
+
+void target_predictor_init(Target_Predictor *tp);
+int target_predictor_predict(Target_Predictor *tp, int opcode, int pc, int rs1, int rd, int *target);
+void target_predictor_train(Target_Predictor *tp, int pc, int target);
+Ras_State target_predictor_ras_state(const Target_Predictor *tp);
+void target_predictor_ras_restore(Target_Predictor *tp, Ras_State state);
+
+#endif
@@ -0,0 +1,156 @@
+/*
+ * timing_wheel.c
+ * Contains the event scheduler used for multi-cycle FU completions and memory responses
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "timing_wheel.h"
+
+/*
+This method clears every slot of the wheel
+*/
+void
+timing_wheel_init(Timing_Wheel *wheel)
+{
+    memset(wheel, 0, sizeof(Timing_Wheel));
+}
+
+/*
+This method schedules an event of the given type delay cycles after now. An event with no delay
+fires immediately. Returns FALSE if the slot is full.
+*/
+int
+timing_wheel_schedule(Timing_Wheel *wheel, int now, int delay, int type)
+{
+    int slot;
+
+    if (delay <= 0)
+    {
+        wheel->fired |= type;
+        return TRUE;
+    }
+
+    slot = (now + delay) & (TIMING_WHEEL_SLOTS - 1);
+    if (wheel->slot_count[slot] == TIMING_WHEEL_SLOT_DEPTH)
+    {
+        fprintf(stderr, "APEX_Error: Timing wheel slot %d is full\n", slot);
+        return FALSE;
+    }
+
+    wheel->slots[slot][wheel->slot_count[slot]].type = type;
+    wheel->slots[slot][wheel->slot_count[slot]].due = now + delay;
+    wheel->slot_count[slot]++;
+    wheel->pending++;
+
+    return TRUE;
+}
+
+/*
+This method fires every event due in the current cycle. It is called once at the start of a cycle.
+*/
+void
+timing_wheel_advance(Timing_Wheel *wheel, int now)
+{
+    int slot = now & (TIMING_WHEEL_SLOTS - 1);
+    int kept = 0;
+
+    if (wheel->pending == 0)
+    {
+        return;
+    }
+
+    for (int i = 0; i < wheel->slot_count[slot]; i++)
+    {
+        if (wheel->slots[slot][i].due <= now)
+        {
+            wheel->fired |= wheel->slots[slot][i].type;
+            wheel->pending--;
+        }
+        else
+        {
+            wheel->slots[slot][kept++] = wheel->slots[slot][i];
+        }
+    }
+
+    wheel->slot_count[slot] = kept;
+}
+
+/*
+This method consumes a fired event. Returns TRUE if an event of the given type has fired.
+*/
+int
+timing_wheel_take(Timing_Wheel *wheel, int type)
+{
+    if (wheel->fired & type)
+    {
+        wheel->fired &= ~type;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/*
+This method drops every pending or fired event of the given type, for a unit whose instruction was squashed
+*/
+void
+timing_wheel_cancel(Timing_Wheel *wheel, int type)
+{
+    wheel->fired &= ~type;
+
+    for (int slot = 0; slot < TIMING_WHEEL_SLOTS && wheel->pending > 0; slot++)
+    {
+        int kept = 0;
+
+        for (int i = 0; i < wheel->slot_count[slot]; i++)
+        {
+            if (wheel->slots[slot][i].type == type)
+            {
+                wheel->pending--;
+            }
+            else
+            {
+                wheel->slots[slot][kept++] = wheel->slots[slot][i];
+            }
+        }
+
+        wheel->slot_count[slot] = kept;
+    }
+}
+
+/*
+This method returns the earliest cycle after now in which an event is due, -1 if nothing is pending.
+The slots are walked in the order of the current turn of the wheel, events due in a later turn are
+only looked at when the current turn has none.
+*/
+int
+timing_wheel_next_due(const Timing_Wheel *wheel, int now)
+{
+    int next_due = -1;
+
+    if (wheel->pending == 0)
+    {
+        return -1;
+    }
+
+    for (int delay = 1; delay <= TIMING_WHEEL_SLOTS; delay++)
+    {
+        int slot = (now + delay) & (TIMING_WHEEL_SLOTS - 1);
+
+        for (int i = 0; i < wheel->slot_count[slot]; i++)
+        {
+            if (wheel->slots[slot][i].due == now + delay)
+            {
+                return now + delay;
+            }
+
+            if (next_due == -1 || wheel->slots[slot][i].due < next_due)
+            {
+                next_due = wheel->slots[slot][i].due;
+            }
+        }
+    }
+
+    return next_due;
+}
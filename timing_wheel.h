@@ -0,0 +1,36 @@
+/*
+ * timing_wheel.h
+ * Contains the event scheduler used for multi-cycle FU completions and memory responses
+ *
+ * Events are kept in a ring of TIMING_WHEEL_SLOTS slots indexed by the cycle they are due in.
+ * At the start of every cycle the slot of the current cycle is drained into a mask of fired
+ * event types, which the owning unit consumes with timing_wheel_take(). An event due more than
+ * TIMING_WHEEL_SLOTS cycles ahead waits in its slot for as many turns of the wheel as it takes.
+ */
+#ifndef _TIMING_WHEEL_H_
+#define _TIMING_WHEEL_H_
+
+#include "apex_macros.h"
+
+typedef struct Wheel_Event
+{
+    int type;       /* One of the EVENT_* bits */
+    int due;        /* Clock cycle the event fires in */
+} Wheel_Event;
+
+typedef struct Timing_Wheel
+{
+    Wheel_Event slots[TIMING_WHEEL_SLOTS][TIMING_WHEEL_SLOT_DEPTH];
+    int slot_count[TIMING_WHEEL_SLOTS];
+    int pending;    /* Events scheduled but not fired yet */
+    int fired;      /* EVENT_* bits fired and not consumed yet */
+} Timing_Wheel;
+
+void timing_wheel_init(Timing_Wheel *wheel);
+int timing_wheel_schedule(Timing_Wheel *wheel, int now, int delay, int type);
+void timing_wheel_advance(Timing_Wheel *wheel, int now);
+int timing_wheel_take(Timing_Wheel *wheel, int type);
+void timing_wheel_cancel(Timing_Wheel *wheel, int type);
+int timing_wheel_next_due(const Timing_Wheel *wheel, int now);
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * value_predictor.c
+ * Contains the load value predictor, which guesses the value a LOAD/LOADP returns from the values it
+ * returned before
+ */
+#include "value_predictor.h"
+
+static int
+value_pred_index(int pc)
+{
+    return (pc >> 2) & (VALUE_PRED_SIZE - 1);
+}
+
+void
+value_predictor_init(Value_Predictor *vp)
+{
+    for (int i = 0; i < VALUE_PRED_SIZE; i++)
+    {
+        vp->pc[i] = -1;
+        vp->last_value[i] = 0;
+        vp->stride[i] = 0;
+        vp->confidence[i] = 0;
+        vp->in_flight[i] = 0;
+    }
+}
+
+/*
+This method looks up the load renamed at pc and counts it in flight. Returns TRUE and the predicted
+value in *value if the entry of pc is confident, FALSE otherwise. A load the table has no entry for
+takes over the entry of its index.
+*/
+int
+value_predictor_predict(Value_Predictor *vp, int pc, int *value)
+{
+    int i = value_pred_index(pc);
+    int confident;
+
+    if (vp->pc[i] != pc)
+    {
+        vp->pc[i] = pc;
+        vp->stride[i] = 0;
+        vp->confidence[i] = -1;         /* No value seen yet */
+        vp->in_flight[i] = 1;
+        return FALSE;
+    }
+
+    confident = vp->confidence[i] >= VALUE_PRED_CONFIDENCE;
+    *value = vp->last_value[i] + vp->stride[i] * (1 + vp->in_flight[i]);
+    vp->in_flight[i]++;
+
+    return confident;
+}
+
+/*
+This method trains the entry of pc with the value the load at pc returned
+*/
+void
+value_predictor_train(Value_Predictor *vp, int pc, int value)
+{
+    int i = value_pred_index(pc);
+
+    /* The entry went to another load while this one was in flight */
+    if (vp->pc[i] != pc)
+    {
+        return;
+    }
+
+    if (vp->in_flight[i] > 0)
+    {
+        vp->in_flight[i]--;
+    }
+
+    if (vp->confidence[i] < 0)
+    {
+        vp->confidence[i] = 0;
+    }
+    else if (value == vp->last_value[i] + vp->stride[i])
+    {
+        if (vp->confidence[i] < VALUE_PRED_CONFIDENCE)
+        {
+            vp->confidence[i]++;
+        }
+    }
+    else
+    {
+        vp->stride[i] = value - vp->last_value[i];
+        vp->confidence[i] = 0;
+    }
+
+    vp->last_value[i] = value;
+}
+
+/*
+This method forgets every load in flight, for the pipeline to count again the ones a flush leaves
+*/
+void
+value_predictor_clear_in_flight(Value_Predictor *vp)
+{
+    for (int i = 0; i < VALUE_PRED_SIZE; i++)
+    {
+        vp->in_flight[i] = 0;
+    }
+}
+
+void
+value_predictor_add_in_flight(Value_Predictor *vp, int pc)
+{
+    int i = value_pred_index(pc);
+
+    if (vp->pc[i] == pc)
+    {
+        vp->in_flight[i]++;
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * value_predictor.h
+ * Contains the load value predictor, which guesses the value a LOAD/LOADP returns from the values it
+ * returned before
+ *
+ * The predictor is a direct-mapped table indexed by PC. An entry holds the last value the load at the
+ * PC returned and the stride between its last two values, and predicts the last value plus one stride
+ * for every instance of the load still in flight ahead of the one predicted. Loads returning the same
+ * value every time are the stride 0 case. A confidence counter counts the values in a row the stride
+ * got right and only a saturated entry supplies a prediction, since a wrong one flushes the pipeline.
+ *
+ * Entries are trained with the values of the loads as they complete, which is in program order.
+ */
+#ifndef _VALUE_PREDICTOR_H_
+#define _VALUE_PREDICTOR_H_
+
+#include "apex_macros.h"
+
+#define VALUE_PRED_SIZE 64          /* Table entries, must be a power of two */
+#define VALUE_PRED_CONFIDENCE 3     /* Strides confirmed in a row before the entry predicts */
+
+typedef struct Value_Predictor
+{
+    int pc[VALUE_PRED_SIZE];        /* PC the entry was trained by, -1 if empty */
+    int last_value[VALUE_PRED_SIZE];
+    int stride[VALUE_PRED_SIZE];
+    int confidence[VALUE_PRED_SIZE];
+    int in_flight[VALUE_PRED_SIZE]; /* Instances renamed and not trained yet */
+} Value_Predictor;
+
+void value_predictor_init(Value_Predictor *vp);
+int value_predictor_predict(Value_Predictor *vp, int pc, int *value);
+void value_predictor_train(Value_Predictor *vp, int pc, int value);
+void value_predictor_clear_in_flight(Value_Predictor *vp);
+void value_predictor_add_in_flight(Value_Predictor *vp, int pc);
+
+#endif